@@ -7,6 +7,7 @@
 #include "NeighList.h"
 #include "PheromoneArray.h"
 #include "utils.h"
+#include "ExactMIS.h"
 
 struct Ant{
 
@@ -18,12 +19,29 @@ struct Ant{
     float beta;                         // degree heuristic influence exponent
     float gamma;                        // degeneracy heuristic influence exponent
     float delta;                        // conflict heuristic influence exponent
+    std::mt19937 *rng;                  // random generator (shared with the solver)
 
     // Precomputed heuristics (static during construction)
     float *degreeH;                     // precomputed degree heuristic (if beta != 0)
     float *degeneracyH;                 // precomputed degeneracy heuristic (if gamma != 0)
+    bool ownsHeuristics;                // false if the arrays belong to another ant
 
-    Ant(NeighList *nl, pheromoneArray *pheromones, float alpha, float beta, float gamma, float delta)
+    // Exact completion of small residual subproblems
+    int exactThreshold;                 // switch to exact search at this many candidates (0 = off)
+    ExactMIS *exact;                    // branch and bound solver (allocated when enabled)
+    int *localIdx;                      // scratch node -> subproblem index map for exact
+
+    // Candidate-list construction
+    int candidateK;                     // pool size (0 = consider every valid node)
+    const vector<int> *candidateOrder;  // nodes ranked by static score (owned by the solver)
+    const vector<float> *candidateScore; // static score of each node (owned by the solver)
+
+    /*
+        Ant: heuristicsFrom, if given, is an ant with the same graph and exponents
+        whose heuristic arrays are shared instead of computing a copy.
+    */
+    Ant(NeighList *nl, pheromoneArray *pheromones, float alpha, float beta, float gamma, float delta, std::mt19937 *rng,
+        Ant *heuristicsFrom = nullptr)
      : pheromones(*pheromones) {
         this->global_pheromones = pheromones;
         this->nl = nl;
@@ -32,6 +50,39 @@ struct Ant{
         this->beta = beta;
         this->gamma = gamma;
         this->delta = delta;
+        this->rng = rng;
+
+        degreeH = nullptr;
+        degeneracyH = nullptr;
+        ownsHeuristics = false;
+        if (heuristicsFrom) {
+            shareHeuristics(heuristicsFrom);
+        } else {
+            buildHeuristics();
+        }
+
+        exactThreshold = 0;
+        exact = nullptr;
+        localIdx = nullptr;
+
+        candidateK = 0;
+        candidateOrder = nullptr;
+        candidateScore = nullptr;
+    }
+    ~Ant(){
+        delete sol;
+        if (exact) delete exact;
+        if (localIdx) delete[] localIdx;
+        freeHeuristics();
+    }
+    /*
+        buildHeuristics: (re)computes the static heuristics from the current graph.
+        Must be called again after the graph's edges change; ants sharing this
+        ant's arrays must share them again afterwards.
+    */
+    void buildHeuristics() {
+        freeHeuristics();
+        ownsHeuristics = true;
 
         // Precompute degree heuristic if beta != 0
         if (beta != 0.0f) {
@@ -53,17 +104,59 @@ struct Ant{
             degeneracyH = nullptr;
         }
     }
-    ~Ant(){
-        delete sol;
-        if (degreeH) delete[] degreeH;
-        if (degeneracyH) delete[] degeneracyH;
+
+    // shareHeuristics: point to the heuristic arrays of owner instead of owning a copy
+    void shareHeuristics(Ant *owner) {
+        freeHeuristics();
+        degreeH = owner->degreeH;
+        degeneracyH = owner->degeneracyH;
+        ownsHeuristics = false;
     }
+
+    void freeHeuristics() {
+        if (ownsHeuristics) {
+            if (degreeH) delete[] degreeH;
+            if (degeneracyH) delete[] degeneracyH;
+        }
+        degreeH = nullptr;
+        degeneracyH = nullptr;
+    }
+
     void reset() {
         this->pheromones = *global_pheromones;
         delete sol;
         sol = new MISP_Solution(nl);
     }
 
+    /*
+        enableExactCompletion: once at most threshold candidates remain, finish the
+        construction with an exact maximum independent set of the remaining candidates.
+        nodeLimit bounds each branch and bound search (0 = unbounded).
+        threshold is capped at ExactMIS::MAX_NODES: the bitset rows grow with the
+        square of the subproblem size, and larger subproblems rarely finish
+        within the node limit anyway.
+    */
+    void enableExactCompletion(int threshold, long long nodeLimit) {
+        exactThreshold = std::min(threshold, ExactMIS::MAX_NODES);
+        if (exact) delete exact;
+        exact = new ExactMIS(nodeLimit);
+        if (localIdx == nullptr) {
+            localIdx = new int[nl->n];
+            for (int i = 0; i < nl->n; i++) localIdx[i] = -1;
+        }
+    }
+
+    /*
+        loadSolution: replaces the current solution with the given nodes
+        (e.g. a cached local search result), keeping the work counter.
+    */
+    void loadSolution(const vector<int>& nodes) {
+        long long work = sol->work;
+        delete sol;
+        sol = new MISP_Solution(nl, const_cast<int*>(nodes.data()), nodes.size());
+        sol->work += work;
+    }
+
     // Degree heuristic (precomputed)
     float degreeHeuristic(int node) {
         return degreeH ? degreeH[node] : 1.0f;
@@ -87,6 +180,7 @@ struct Ant{
     void buildWeights(vector<int>& candidates, vector<float>& weights, const vector<int>& source) {
         candidates.clear();
         weights.clear();
+        sol->work += source.size();
         for (int node : source) {
             float tau = pheromones.getPheromone(node);
             if (tau > 0.0f) {
@@ -104,6 +198,10 @@ struct Ant{
         pheromones^(alpha) * degreeHeuristic^(beta) * degeneracyHeuristic^(gamma) * conflictHeuristic^(delta)
     */
     int constructSolution() {
+        if (candidateK > 0 && candidateOrder != nullptr) {
+            return constructSolutionPooled();
+        }
+
         // Initial source: all nodes
         vector<int> allNodes(nl->n);
         for (int i = 0; i < nl->n; i++) allNodes[i] = i;
@@ -111,8 +209,27 @@ struct Ant{
         vector<int> candidates;
         vector<float> weights;
         buildWeights(candidates, weights, allNodes);
+
+        bool exactDone = false;
+        vector<int> exactNodes;
         
         while (!candidates.empty()) {
+            // Small residual subproblem: add a maximum independent set of the candidates
+            if (exactThreshold > 0 && !exactDone && (int)candidates.size() <= exactThreshold) {
+                exactDone = true;
+                exact->solve(nl, candidates, localIdx, exactNodes);
+                sol->work += exact->work;
+                for (int node : exactNodes) {
+                    sol->addNode(node);
+                    pheromones.invalidate(node);
+                    pheromones.invalidateVector(nl->neighbors(node));
+                }
+                // Empty unless the node limit cut the search short
+                vector<int> oldCandidates = candidates;
+                buildWeights(candidates, weights, oldCandidates);
+                continue;
+            }
+
             // Calculate total weight
             float total = 0.0f;
             for (float w : weights) total += w;
@@ -120,7 +237,7 @@ struct Ant{
             if (total <= 0.0f) break;
             
             // Roulette wheel selection
-            float randVal = static_cast<float>(rand()) / RAND_MAX * total;
+            float randVal = static_cast<float>((*rng)()) / std::mt19937::max() * total;
             float cumulative = 0.0f;
             int selectedIdx = 0;
             
@@ -137,7 +254,7 @@ struct Ant{
             
             // Mark selected node and its neighbors as invalid
             pheromones.invalidate(selectedNode);
-            pheromones.invalidateVector(nl->neighborhoods[selectedNode]);
+            pheromones.invalidateVector(nl->neighbors(selectedNode));
             
             // Rebuild candidates - must copy source first since buildWeights clears it
             vector<int> oldCandidates = candidates;
@@ -147,6 +264,75 @@ struct Ant{
         return sol->size();
     }
 
+    /*
+        constructSolutionPooled: candidate-list variant of constructSolution.
+        Each step samples only from a pool of at most candidateK valid nodes taken
+        from candidateOrder (ranked by pheromones^alpha * degree * degeneracy heuristics).
+        A pooled node's weight is its static score times the conflict heuristic.
+        Invalidated entries are dropped and the pool is refilled lazily from the
+        ranking; the pool only runs empty once no valid node is left.
+        Per-step cost is O(candidateK) plus the amortized scan of the ranking.
+        Exact completion does not apply in this mode.
+    */
+    int constructSolutionPooled() {
+        const vector<int> &order = *candidateOrder;
+        const vector<float> &score = *candidateScore;
+        size_t cursor = 0;
+
+        vector<int> pool;
+        vector<float> weights;
+        pool.reserve(candidateK);
+        weights.reserve(candidateK);
+
+        while (true) {
+            // Drop invalidated entries and refill from the ranking
+            size_t keep = 0;
+            for (int node : pool) {
+                if (pheromones.getPheromone(node) > 0.0f) pool[keep++] = node;
+            }
+            pool.resize(keep);
+            while ((int)pool.size() < candidateK && cursor < order.size()) {
+                int node = order[cursor++];
+                sol->work++;
+                if (pheromones.getPheromone(node) > 0.0f) pool.push_back(node);
+            }
+            if (pool.empty()) break;
+
+            weights.clear();
+            sol->work += pool.size();
+            float total = 0.0f;
+            for (int node : pool) {
+                float weight = score[node] * conflictHeuristic(node);
+                weights.push_back(weight);
+                total += weight;
+            }
+
+            if (total <= 0.0f) break;
+
+            // Roulette wheel selection over the pool
+            float randVal = static_cast<float>((*rng)()) / std::mt19937::max() * total;
+            float cumulative = 0.0f;
+            int selectedIdx = 0;
+
+            for (size_t i = 0; i < pool.size(); i++) {
+                cumulative += weights[i];
+                if (randVal <= cumulative) {
+                    selectedIdx = i;
+                    break;
+                }
+            }
+
+            int selectedNode = pool[selectedIdx];
+            sol->addNode(selectedNode);
+
+            // Mark selected node and its neighbors as invalid
+            pheromones.invalidate(selectedNode);
+            pheromones.invalidateVector(nl->neighbors(selectedNode));
+        }
+
+        return sol->size();
+    }
+
     /*
         depositInSolution: deposits pheromones in all nodes of the current solution.
         MMAS: deposit amount = 1/solution_quality (or proportional to quality)
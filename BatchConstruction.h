@@ -0,0 +1,155 @@
+#pragma once
+
+#include <random>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+#include "NeighList.h"
+#include "PheromoneArray.h"
+#include "Ant.h"
+
+using std::vector;
+
+/*
+    BatchConstructor: builds the solutions of up to 64 ants in lockstep.
+    State is kept as structure-of-arrays over nodes: avail[v] has bit b set
+    while node v is still a valid choice for ant b.
+    Every step does two passes over the nodes that are still alive for some ant
+    (totals, then roulette selection for all ants at once), and the adjacency
+    of each chosen node is walked once for all ants that picked it.
+    Node weights follow Ant::constructSolution: pheromones^alpha times the
+    degree and degeneracy heuristics. The conflict heuristic is always 1 there
+    (a valid node has no solution neighbor), so no per-ant counters are kept
+    and a node weighs the same for every ant.
+*/
+struct BatchConstructor {
+    static constexpr int MAX_BATCH = 64;
+
+    NeighList *nl;
+    int B;                          // ants per batch (<= MAX_BATCH)
+    float alpha;                    // pheromone influence exponent
+    std::mt19937 *rng;              // random generator (shared with the solver)
+    long long work;                 // work units spent since construction
+
+    vector<uint64_t> avail;         // per-node availability mask over ants
+    vector<float> weight;           // weight of each node for this construction
+    vector<int> alive;              // nodes available to at least one active ant
+    vector<long long> picks;        // (node, ant) choices of the current step, packed as node * 64 + ant
+
+    BatchConstructor(NeighList *nl, int B, float alpha, std::mt19937 *rng) {
+        this->nl = nl;
+        this->B = std::min(B, MAX_BATCH);
+        this->alpha = alpha;
+        this->rng = rng;
+        work = 0;
+
+        avail.resize(nl->n);
+        weight.resize(nl->n);
+    }
+
+    /*
+        construct: builds count (<= B) solutions from the global pheromones.
+        heuristics supplies the static degree/degeneracy heuristics.
+        out[b] receives the nodes chosen by ant b.
+    */
+    void construct(int count, pheromoneArray &pheromones, Ant *heuristics, vector<vector<int>> &out) {
+        int n = nl->n;
+        uint64_t full = count >= 64 ? ~0ULL : ((1ULL << count) - 1);
+
+        out.resize(count);
+        for (int b = 0; b < count; b++) out[b].clear();
+
+        alive.clear();
+        for (int v = 0; v < n; v++) {
+            float tau = pheromones.getPheromone(v);
+            if (tau > 0.0f) {
+                weight[v] = powf(tau, alpha) * heuristics->degreeHeuristic(v) * heuristics->degeneracyHeuristic(v);
+                avail[v] = full;
+                alive.push_back(v);
+            } else {
+                avail[v] = 0;
+            }
+        }
+        work += n;
+
+        uint64_t active = full;
+        float total[MAX_BATCH], target[MAX_BATCH], cumulative[MAX_BATCH];
+        int last[MAX_BATCH];
+
+        while (active) {
+            // Pass 1: total weight per ant, compacting nodes no active ant can take
+            for (int b = 0; b < count; b++) total[b] = 0.0f;
+            size_t keep = 0;
+            for (int v : alive) {
+                uint64_t mask = avail[v] & active;
+                if (!mask) continue;
+                alive[keep++] = v;
+                float w = weight[v];
+                while (mask) {
+                    int b = __builtin_ctzll(mask);
+                    mask &= mask - 1;
+                    total[b] += w;
+                }
+            }
+            work += alive.size();
+            alive.resize(keep);
+
+            for (int b = 0; b < count; b++) {
+                if (!((active >> b) & 1)) continue;
+                if (total[b] <= 0.0f) {
+                    active &= ~(1ULL << b);
+                    continue;
+                }
+                target[b] = static_cast<float>((*rng)()) / std::mt19937::max() * total[b];
+                cumulative[b] = 0.0f;
+                last[b] = -1;
+            }
+            if (!active) break;
+
+            // Pass 2: roulette wheel selection for every active ant in one sweep
+            uint64_t pending = active;
+            picks.clear();
+            for (size_t i = 0; i < alive.size() && pending; i++) {
+                int v = alive[i];
+                uint64_t mask = avail[v] & pending;
+                float w = weight[v];
+                while (mask) {
+                    int b = __builtin_ctzll(mask);
+                    mask &= mask - 1;
+                    cumulative[b] += w;
+                    last[b] = v;
+                    if (target[b] <= cumulative[b]) {
+                        picks.push_back((long long)v * 64 + b);
+                        pending &= ~(1ULL << b);
+                    }
+                }
+            }
+            // Rounding can leave the target just above the final sum
+            while (pending) {
+                int b = __builtin_ctzll(pending);
+                pending &= pending - 1;
+                picks.push_back((long long)last[b] * 64 + b);
+            }
+
+            // Apply choices, walking each chosen node's adjacency once for all its ants
+            std::sort(picks.begin(), picks.end());
+            for (size_t i = 0; i < picks.size();) {
+                int v = (int)(picks[i] / 64);
+                uint64_t ants = 0;
+                for (; i < picks.size() && picks[i] / 64 == v; i++) {
+                    int b = (int)(picks[i] % 64);
+                    ants |= 1ULL << b;
+                    out[b].push_back(v);
+                }
+
+                avail[v] &= ~ants;
+                for (int u : nl->neighbors(v)) {
+                    avail[u] &= ~ants;
+                }
+                work += nl->degrees[v];
+            }
+        }
+    }
+};
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <csignal>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/*
+    Checkpoint: snapshot of an MMAS run taken at an iteration boundary.
+    Ants are reset every iteration, so the pheromones and their bounds, the
+    incumbents, counters and RNG state are enough to continue the run exactly
+    where it stopped.
+    The solution cache is not saved: a resumed run starts with an empty cache.
+    Local search is deterministic, so it still builds the same solutions, but
+    constructions the cache would have answered run local search again and
+    charge its work, so the work counter (and a -w work budget) and the hit
+    rate only approximately match an uninterrupted run when the cache is on.
+
+    Binary layout (native endianness):
+    magic[8] "MMASCKPT", uint32 version,
+    int32 n, int32 iterations, double elapsed, int64 work, int64 ils_spent,
+    int32 best_size, int32 best_solution[best_size],
+    float pheromones[n], float tau_min, float tau_max,
+    int32 restart_best_size, int32 restart_best_solution[restart_best_size],
+    int32 last_restart, int32 last_improvement,
+    uint32 rng_len, char rng_state[rng_len]
+*/
+struct Checkpoint {
+    int n;                              // number of nodes of the graph
+    int iterations;                     // completed iterations
+    double elapsed;                     // seconds spent in solve() so far
+    long long work;                     // work units spent so far
+    long long ils_spent;                // work units spent in iterated local search so far
+    std::vector<int> best_solution;     // incumbent nodes
+    std::vector<float> pheromones;      // global pheromone levels
+    float tau_min, tau_max;             // pheromone bounds (adaptive bounds change them)
+    std::vector<int> restart_best_solution; // best nodes since the last restart
+    int last_restart;                   // iteration of the last pheromone restart
+    int last_improvement;               // iteration of the last restart-best improvement
+    std::string rng_state;              // serialized std::mt19937
+
+    static constexpr uint32_t VERSION = 4;
+    static constexpr uint32_t MAX_RNG_STATE = 16384;   // serialized mt19937 is about 7 KB of text
+
+    Checkpoint() : n(0), iterations(0), elapsed(0.0), work(0), ils_spent(0), tau_min(0.0f), tau_max(0.0f),
+                   last_restart(0), last_improvement(0) {}
+
+    /*
+        save: writes the checkpoint to path + ".tmp" and renames it over path,
+        so a crash while writing never leaves a truncated checkpoint behind.
+        Returns false on I/O error.
+    */
+    bool save(const char *path) const {
+        std::string tmpPath = std::string(path) + ".tmp";
+        FILE *fp = fopen(tmpPath.c_str(), "wb");
+        if (fp == NULL) {
+            perror("Error opening checkpoint file");
+            return false;
+        }
+
+        uint32_t version = VERSION;
+        int best_size = best_solution.size();
+        int restart_best_size = restart_best_solution.size();
+        uint32_t rng_len = rng_state.size();
+
+        bool ok = fwrite("MMASCKPT", 1, 8, fp) == 8
+            && fwrite(&version, sizeof(version), 1, fp) == 1
+            && fwrite(&n, sizeof(n), 1, fp) == 1
+            && fwrite(&iterations, sizeof(iterations), 1, fp) == 1
+            && fwrite(&elapsed, sizeof(elapsed), 1, fp) == 1
+            && fwrite(&work, sizeof(work), 1, fp) == 1
+            && fwrite(&ils_spent, sizeof(ils_spent), 1, fp) == 1
+            && fwrite(&best_size, sizeof(best_size), 1, fp) == 1
+            && fwrite(best_solution.data(), sizeof(int), best_size, fp) == (size_t)best_size
+            && fwrite(pheromones.data(), sizeof(float), n, fp) == (size_t)n
+            && fwrite(&tau_min, sizeof(tau_min), 1, fp) == 1
+            && fwrite(&tau_max, sizeof(tau_max), 1, fp) == 1
+            && fwrite(&restart_best_size, sizeof(restart_best_size), 1, fp) == 1
+            && fwrite(restart_best_solution.data(), sizeof(int), restart_best_size, fp) == (size_t)restart_best_size
+            && fwrite(&last_restart, sizeof(last_restart), 1, fp) == 1
+            && fwrite(&last_improvement, sizeof(last_improvement), 1, fp) == 1
+            && fwrite(&rng_len, sizeof(rng_len), 1, fp) == 1
+            && fwrite(rng_state.data(), 1, rng_len, fp) == rng_len;
+
+        if (fclose(fp) != 0) ok = false;
+        if (!ok) {
+            perror("Error writing checkpoint file");
+            remove(tmpPath.c_str());
+            return false;
+        }
+        if (rename(tmpPath.c_str(), path) != 0) {
+            perror("Error renaming checkpoint file");
+            return false;
+        }
+        return true;
+    }
+
+    // load: reads a checkpoint written by save(). Returns false on error.
+    bool load(const char *path) {
+        FILE *fp = fopen(path, "rb");
+        if (fp == NULL) {
+            perror("Error opening checkpoint file");
+            return false;
+        }
+
+        // Sizes read from the header are checked against the file size before allocating
+        fseek(fp, 0, SEEK_END);
+        long fileSize = ftell(fp);
+        fseek(fp, 0, SEEK_SET);
+
+        char magic[8];
+        uint32_t version;
+        int best_size;
+        int restart_best_size;
+        uint32_t rng_len;
+
+        bool ok = fread(magic, 1, 8, fp) == 8 && memcmp(magic, "MMASCKPT", 8) == 0
+            && fread(&version, sizeof(version), 1, fp) == 1 && version == VERSION
+            && fread(&n, sizeof(n), 1, fp) == 1 && n >= 0 && (long long)n * (long long)sizeof(float) <= fileSize
+            && fread(&iterations, sizeof(iterations), 1, fp) == 1
+            && fread(&elapsed, sizeof(elapsed), 1, fp) == 1
+            && fread(&work, sizeof(work), 1, fp) == 1
+            && fread(&ils_spent, sizeof(ils_spent), 1, fp) == 1 && ils_spent >= 0 && ils_spent <= work
+            && fread(&best_size, sizeof(best_size), 1, fp) == 1 && best_size >= 0 && best_size <= n;
+        if (ok) {
+            best_solution.resize(best_size);
+            pheromones.resize(n);
+            ok = fread(best_solution.data(), sizeof(int), best_size, fp) == (size_t)best_size
+                && fread(pheromones.data(), sizeof(float), n, fp) == (size_t)n
+                && fread(&tau_min, sizeof(tau_min), 1, fp) == 1
+                && fread(&tau_max, sizeof(tau_max), 1, fp) == 1 && tau_min > 0.0f && tau_min < tau_max
+                && fread(&restart_best_size, sizeof(restart_best_size), 1, fp) == 1
+                && restart_best_size >= 0 && restart_best_size <= n;
+        }
+        if (ok) {
+            restart_best_solution.resize(restart_best_size);
+            ok = fread(restart_best_solution.data(), sizeof(int), restart_best_size, fp) == (size_t)restart_best_size
+                && fread(&last_restart, sizeof(last_restart), 1, fp) == 1
+                && fread(&last_improvement, sizeof(last_improvement), 1, fp) == 1
+                && fread(&rng_len, sizeof(rng_len), 1, fp) == 1 && rng_len <= MAX_RNG_STATE;
+        }
+        if (ok) {
+            rng_state.resize(rng_len);
+            ok = fread(&rng_state[0], 1, rng_len, fp) == rng_len;
+        }
+
+        fclose(fp);
+        if (!ok) {
+            fprintf(stderr, "Error: Invalid or incompatible checkpoint file: %s\n", path);
+        }
+        return ok;
+    }
+};
+
+/*
+    CheckpointWriter: writes checkpoints on a background thread.
+    submit() swaps the caller's snapshot into the pending slot (O(1)), so the
+    iteration loop never waits on disk. The writer swaps pending into its own
+    buffer before writing; if a newer snapshot arrives meanwhile it replaces
+    the pending one and only the latest is written next.
+*/
+struct CheckpointWriter {
+    std::string path;
+    Checkpoint pending;         // latest submitted snapshot
+    Checkpoint writing;         // snapshot being written by the worker
+    bool hasPending;
+    bool busy;
+    bool stop;
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::thread worker;
+
+    CheckpointWriter(const char *path) : path(path), hasPending(false), busy(false), stop(false) {
+        worker = std::thread(&CheckpointWriter::run, this);
+    }
+
+    ~CheckpointWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stop = true;
+        }
+        cv.notify_all();
+        worker.join();
+    }
+
+    // Hand over a snapshot; snapshot receives a stale buffer for reuse
+    void submit(Checkpoint &snapshot) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            std::swap(pending, snapshot);
+            hasPending = true;
+        }
+        cv.notify_all();
+    }
+
+    // Block until every submitted snapshot is on disk
+    void flush() {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this] { return !hasPending && !busy; });
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (true) {
+            cv.wait(lock, [this] { return hasPending || stop; });
+            if (!hasPending) break;     // stop requested and nothing left to write
+
+            std::swap(writing, pending);
+            hasPending = false;
+            busy = true;
+
+            lock.unlock();
+            writing.save(path.c_str());
+            lock.lock();
+
+            busy = false;
+            cv.notify_all();
+        }
+    }
+};
+
+// Set by the signal handler, polled by the solver at iteration boundaries
+volatile sig_atomic_t checkpointSignal = 0;     // SIGUSR1: checkpoint and continue
+volatile sig_atomic_t stopSignal = 0;           // SIGTERM/SIGINT: checkpoint and stop
+
+void checkpointSignalHandler(int sig) {
+    if (sig == SIGUSR1) {
+        checkpointSignal = 1;
+    } else {
+        stopSignal = 1;
+    }
+}
+
+// Route SIGUSR1, SIGTERM and SIGINT to the checkpoint flags
+void installCheckpointSignals() {
+    signal(SIGUSR1, checkpointSignalHandler);
+    signal(SIGTERM, checkpointSignalHandler);
+    signal(SIGINT, checkpointSignalHandler);
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "NeighList.h"
+
+using std::vector;
+
+/*
+    ExactMIS: maximum independent set of a small induced subgraph by bitset
+    branch and bound. Searches for a maximum clique in the complement graph
+    (MCQ style): vertices are greedily colored (each color class is a clique
+    of the original graph, so it holds at most one solution node) and the
+    number of colors bounds the size reachable from each branch.
+    nodeLimit caps the search tree; the best set found so far is kept.
+*/
+struct ExactMIS {
+    static constexpr int MAX_NODES = 1024;  // largest subproblem accepted as exact completion threshold
+
+    int k;                              // number of nodes in the subproblem
+    int W;                              // 64-bit words per bitset row
+    vector<uint64_t> comp;              // complement adjacency, k rows of W words
+    vector<vector<uint64_t>> P;         // candidate set at each depth
+    vector<vector<int>> order;          // coloring order at each depth
+    vector<vector<int>> bound;          // color (upper bound) of order[i] at each depth
+    vector<uint64_t> colorBuf;          // scratch sets for coloring
+    vector<int> current;                // nodes of the current branch (local indices)
+    vector<int> best;                   // best set found (local indices)
+    long long nodes;                    // search tree nodes expanded
+    long long nodeLimit;                // maximum search tree nodes (0 = no limit)
+    long long work;                     // work units spent in the last solve()
+
+    ExactMIS(long long nodeLimit = 100000) : k(0), W(0), nodes(0), nodeLimit(nodeLimit), work(0) {}
+
+    /*
+        solve: maximum independent set of the subgraph induced by cand.
+        localIdx must have nl->n entries set to -1; it is used as scratch and restored.
+        out receives the chosen nodes (graph ids). Returns false if nodeLimit was hit
+        (out then holds the best set found, not necessarily maximum).
+    */
+    bool solve(NeighList *nl, const vector<int>& cand, int *localIdx, vector<int>& out) {
+        k = cand.size();
+        W = (k + 63) / 64;
+        nodes = 0;
+        work = 0;
+
+        for (int i = 0; i < k; i++) localIdx[cand[i]] = i;
+
+        // Complement adjacency: every other candidate, minus graph neighbors
+        comp.assign((size_t)k * W, 0);
+        for (int i = 0; i < k; i++) {
+            uint64_t *row = &comp[(size_t)i * W];
+            for (int j = 0; j < k; j++) {
+                if (j != i) row[j >> 6] |= 1ULL << (j & 63);
+            }
+            for (int v : nl->neighbors(cand[i])) {
+                int j = localIdx[v];
+                if (j >= 0) row[j >> 6] &= ~(1ULL << (j & 63));
+            }
+            work += k + nl->degrees[cand[i]];
+        }
+
+        for (int i = 0; i < k; i++) localIdx[cand[i]] = -1;
+
+        if (P.size() < (size_t)k + 1) {
+            P.resize(k + 1);
+            order.resize(k + 1);
+            bound.resize(k + 1);
+        }
+        P[0].assign(W, 0);
+        for (int i = 0; i < k; i++) P[0][i >> 6] |= 1ULL << (i & 63);
+        colorBuf.assign(2 * W, 0);
+
+        current.clear();
+        best.clear();
+        bool complete = expand(0);
+        work += nodes * W;
+
+        out.clear();
+        for (int i : best) out.push_back(cand[i]);
+        return complete;
+    }
+
+    static bool isEmpty(const uint64_t *set, int W) {
+        for (int w = 0; w < W; w++) {
+            if (set[w]) return false;
+        }
+        return true;
+    }
+
+    // Greedy coloring of P[depth] in the complement graph into order/bound
+    int colorSort(int depth) {
+        uint64_t *U = &colorBuf[0];
+        uint64_t *Q = &colorBuf[W];
+        vector<int> &ord = order[depth];
+        vector<int> &bnd = bound[depth];
+        ord.clear();
+        bnd.clear();
+
+        for (int w = 0; w < W; w++) U[w] = P[depth][w];
+
+        int color = 0;
+        while (!isEmpty(U, W)) {
+            color++;
+            for (int w = 0; w < W; w++) Q[w] = U[w];
+            for (int w = 0; w < W; w++) {
+                while (Q[w]) {
+                    int v = w * 64 + __builtin_ctzll(Q[w]);
+                    U[w] &= ~(1ULL << (v & 63));
+                    Q[w] &= ~(1ULL << (v & 63));
+                    // Complement neighbors of v cannot share its color
+                    const uint64_t *row = &comp[(size_t)v * W];
+                    for (int x = w; x < W; x++) Q[x] &= ~row[x];
+                    ord.push_back(v);
+                    bnd.push_back(color);
+                }
+            }
+        }
+        return ord.size();
+    }
+
+    // Branch on P[depth]; returns false once nodeLimit is exceeded
+    bool expand(int depth) {
+        nodes++;
+        if (nodeLimit > 0 && nodes > nodeLimit) return false;
+
+        int count = colorSort(depth);
+        vector<uint64_t> &Pd = P[depth];
+        vector<uint64_t> &Pn = P[depth + 1];
+        Pn.resize(W);
+
+        for (int i = count - 1; i >= 0; i--) {
+            if ((int)current.size() + bound[depth][i] <= (int)best.size()) return true;
+
+            int v = order[depth][i];
+            current.push_back(v);
+
+            const uint64_t *row = &comp[(size_t)v * W];
+            for (int w = 0; w < W; w++) Pn[w] = Pd[w] & row[w];
+
+            if (isEmpty(Pn.data(), W)) {
+                if (current.size() > best.size()) best = current;
+            } else if (!expand(depth + 1)) {
+                current.pop_back();
+                return false;
+            }
+
+            current.pop_back();
+            Pd[v >> 6] &= ~(1ULL << (v & 63));
+        }
+        return true;
+    }
+};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <random>
+#include <vector>
+
+#include "NeighList.h"
+#include "LocalSearch.h"
+#include "utils.h"
+
+using std::vector;
+
+/*
+    IteratedLocalSearch: intensification around an incumbent.
+    Each step perturbs the current solution by force-inserting k random nodes
+    (removing their solution neighbors), then repairs it incrementally: nodes
+    left free around the removed ones are added and (1,2)-swaps are applied
+    around the change. A step is kept if the solution does not shrink below
+    the best size seen, and undone otherwise.
+*/
+struct IteratedLocalSearch {
+    NeighList *nl;
+    MISP_Solution *sol;             // current solution
+    std::mt19937 *rng;              // random generator (shared with the solver)
+    int strength;                   // nodes force-inserted per perturbation (k)
+    vector<int> best;               // best solution found since the last reset
+    long long work;                 // work units spent since construction
+
+    vector<int> journal;            // changes made by the current step (for undo)
+    vector<int> removed;            // nodes removed by the perturbation
+    vector<int> queue;              // solution nodes to examine for (1,2)-swaps
+
+    IteratedLocalSearch(NeighList *nl, std::mt19937 *rng, int strength) {
+        this->nl = nl;
+        this->rng = rng;
+        this->strength = strength;
+        sol = new MISP_Solution(nl);
+        work = 0;
+    }
+    ~IteratedLocalSearch() {
+        delete sol;
+    }
+
+    // reset: restart the search from start (e.g. the global best)
+    void reset(const vector<int>& start) {
+        work += sol->work;
+        delete sol;
+        sol = new MISP_Solution(nl, const_cast<int*>(start.data()), start.size());
+        best = start;
+    }
+
+    /*
+        step: one perturbation followed by repair.
+        Returns the size of the current solution after the step.
+    */
+    int step() {
+        long long startWork = sol->work;
+        int *tight = sol->MISP_IndependentDegree;
+
+        journal.clear();
+        sol->journal = &journal;
+        removed.clear();
+        queue.clear();
+
+        // Perturbation: force k random non-solution nodes into the solution
+        for (int f = 0; f < strength; f++) {
+            int v = (*rng)() % nl->n;
+            if (tight[v] == -1) continue;
+            for (int u : nl->neighbors(v)) {
+                if (tight[u] == -1) {
+                    sol->removeNode(u);
+                    removed.push_back(u);
+                }
+            }
+            sol->addNode(v);
+            queue.push_back(v);
+        }
+
+        // Repair: add nodes left free by the removals, then (1,2)-swaps around them
+        for (int u : removed) {
+            for (int y : nl->neighbors(u)) {
+                if (tight[y] == 0) {
+                    sol->addNode(y);
+                    queue.push_back(y);
+                } else if (tight[y] == 1) {
+                    int z = solutionNeighbor(sol, y);
+                    if (z != -1) queue.push_back(z);
+                }
+            }
+        }
+        twoImprovement(sol, queue);
+        sol->journal = nullptr;
+
+        if (sol->size() > (int)best.size()) {
+            best = sol->solution;
+        } else if (sol->size() < (int)best.size()) {
+            undo();
+        }
+
+        // Count at least one unit per step so budget loops always progress
+        if (sol->work == startWork) sol->work++;
+        return sol->size();
+    }
+
+    // undo: replay the step's journal backwards to restore the solution it started from
+    void undo() {
+        for (int i = (int)journal.size() - 1; i >= 0; i--) {
+            int entry = journal[i];
+            if (entry >= 0) {
+                sol->removeNode(entry);
+            } else {
+                sol->addNode(~entry);
+            }
+        }
+    }
+
+    // Work units spent so far, including the current solution
+    long long totalWork() const {
+        return work + sol->work;
+    }
+};
@@ -8,6 +8,7 @@
 int try1Adds(MISP_Solution *sol) {
     int n = sol->graph->n;
     int added = 0;
+    sol->work += n;
 
     for (int node = 0; node < n; node++) {
         if (sol->MISP_IndependentDegree[node] == 0) {
@@ -32,6 +33,7 @@ void localSearch(MISP_Solution *sol, int budget) {
 
         // try 1-1 improving swaps
         bool improvement = false;
+        sol->work += n;
         for (int node_in = 0; node_in < n; node_in++) {
             if (sol->MISP_IndependentDegree[node_in] == 1) {
 
@@ -40,6 +42,7 @@ void localSearch(MISP_Solution *sol, int budget) {
                 for (int nd : sol->solution)
                     if (sol->graph->isNeighbor(node_in, nd))
                         node_out = nd;
+                sol->work += (long long)sol->size() * sol->graph->degrees[node_in];
 
                 if (node_out == -1) {
                     std::cerr << "Error: Inconsistent independent degree for node " << node_in << "\n";
@@ -75,6 +78,7 @@ void localSearch(MISP_Solution *sol, int budget) {
 
         // do any 2-1 swap if at least 2 budget
         bool swapFound = false;
+        sol->work += n;
         for (int i = 0; i < n; i++) {
             if (sol->MISP_IndependentDegree[i] == 2) {
 
@@ -82,6 +86,7 @@ void localSearch(MISP_Solution *sol, int budget) {
                 int node_out1 = -1;
                 int node_out2 = -1;
                 for (int nd : sol->solution) {
+                    sol->work += sol->graph->degrees[i];
                     if (sol->graph->isNeighbor(i, nd)) {
                         if (node_out1 == -1) {
                             node_out1 = nd;
@@ -121,3 +126,79 @@ void localSearch(MISP_Solution *sol, int budget) {
         }
     }
 }
+
+// Find the solution node adjacent to node (node must be 1-tight), or -1
+int solutionNeighbor(MISP_Solution *sol, int node) {
+    for (int nd : sol->graph->neighbors(node)) {
+        if (sol->MISP_IndependentDegree[nd] == -1) {
+            return nd;
+        }
+    }
+    return -1;
+}
+
+/*
+    twoImprovement: incremental (1,2)-swaps. Replaces a solution node x by two
+    non-adjacent neighbors of x whose only solution neighbor is x (1-tight).
+    queue holds the solution nodes to examine; nodes affected by each swap are
+    pushed back, so only the region around changes is revisited.
+    Returns the number of swaps applied.
+*/
+int twoImprovement(MISP_Solution *sol, std::vector<int> &queue) {
+    NeighList *graph = sol->graph;
+    int *tight = sol->MISP_IndependentDegree;
+    std::vector<int> oneTight;
+    int swaps = 0;
+
+    while (!queue.empty()) {
+        int x = queue.back();
+        queue.pop_back();
+        if (tight[x] != -1) continue;   // no longer in the solution
+
+        oneTight.clear();
+        for (int u : graph->neighbors(x)) {
+            if (tight[u] == 1) oneTight.push_back(u);
+        }
+        sol->work += graph->degrees[x];
+        if (oneTight.size() < 2) continue;
+
+        // find two non-adjacent 1-tight neighbors
+        int a = -1, b = -1;
+        for (size_t i = 0; i < oneTight.size() && a == -1; i++) {
+            for (size_t j = i + 1; j < oneTight.size(); j++) {
+                sol->work += graph->degrees[oneTight[i]];
+                if (!graph->isNeighbor(oneTight[i], oneTight[j])) {
+                    a = oneTight[i];
+                    b = oneTight[j];
+                    break;
+                }
+            }
+        }
+        if (a == -1) continue;
+
+        // apply swap, then add any other neighbor of x left free
+        sol->removeNode(x);
+        sol->addNode(a);
+        sol->addNode(b);
+        queue.push_back(a);
+        queue.push_back(b);
+        for (int u : oneTight) {
+            if (tight[u] == 0) {
+                sol->addNode(u);
+                queue.push_back(u);
+            }
+        }
+
+        // neighbors of x that became 1-tight open new swaps around their solution neighbor
+        for (int u : graph->neighbors(x)) {
+            if (tight[u] == 1) {
+                int z = solutionNeighbor(sol, u);
+                sol->work += graph->degrees[u];
+                if (z != -1) queue.push_back(z);
+            }
+        }
+        swaps++;
+    }
+
+    return swaps;
+}
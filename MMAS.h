@@ -1,16 +1,34 @@
+#pragma once
+
 #include <chrono>
 #include <cstring>
+#include <cmath>
+#include <cfloat>
 #include <algorithm>
+#include <utility>
+#include <random>
+#include <sstream>
 
 #include "Ant.h"
 #include "PheromoneArray.h"
 #include "LocalSearch.h"
+#include "Checkpoint.h"
+#include "SolutionCache.h"
+#include "Intensification.h"
+#include "BatchConstruction.h"
+#include "PerfCounters.h"
 
 using namespace std;
 
 /*
-    MMAS (Max-Min Ant System) for Maximum Independent Set Problem.
-    
+    MMASSolver: persistent Max-Min Ant System for the Maximum Independent Set Problem.
+    Owns the colony and the pheromone array, so successive solve() calls continue
+    from the current pheromones and incumbent instead of starting cold.
+    Edge batches can be applied to the graph between solves; the incumbent is
+    repaired to stay independent. With checkpoints enabled, the run state is
+    snapshotted periodically and on SIGUSR1/SIGTERM/SIGINT, and restore()
+    continues a run from such a snapshot.
+
     Parameters:
     - m: number of ants per iteration
     - alpha: pheromone influence exponent
@@ -20,90 +38,734 @@ using namespace std;
     - rho: evaporation rate
     - tau_min, tau_max: pheromone bounds
     - ls_budget: local search budget (0=off, 1=1-1 swaps, >1=also 2-1 swaps)
+    - seed: random generator seed
+    Optional MMAS convergence control: adaptive bounds, restarts on a converged
+    trail and a deposit schedule (see enableAdaptiveBounds, enableRestarts and
+    enableDepositSchedule).
 */
-int MMAS(NeighList *nl, double time_limit, int m, float alpha, float beta, float gamma, float delta, float rho,
-         float tau_min = 1.0f, float tau_max = 100.0f, int ls_budget = 1,
-         bool verbose = false, int *iterations = nullptr) {
+struct MMASSolver {
+    NeighList *nl;                      // graph (edges may change between solves)
+    int m;                              // number of ants per iteration
+    float alpha, beta, gamma, delta;    // heuristic exponents
+    int ls_budget;                      // local search budget
+    bool verbose;                       // verbose flag
+
+    pheromoneArray pheromones;          // global pheromone array
+    vector<Ant*> colony;                // m ants
+
+    int global_best_size;               // incumbent size
+    vector<int> global_best_solution;   // incumbent nodes
+    vector<int> iteration_best_solution; // best nodes of the current iteration (deposited)
+    int iterations;                     // iterations over all solve() calls
+    double elapsed;                     // seconds spent in solve() over all calls
+    long long work;                     // work units (adjacency entries / nodes touched) over all calls
+    std::mt19937 rng;                   // random generator shared by the ants
+
+    // Checkpointing (disabled while checkpointWriter is nullptr)
+    CheckpointWriter *checkpointWriter; // background checkpoint writer
+    double checkpointInterval;          // seconds between periodic checkpoints (0 = on signal only)
+    double lastCheckpoint;              // elapsed time of the last checkpoint
+    Checkpoint snapshotBuffer;          // reusable snapshot buffer
+    bool interrupted;                   // last solve() was stopped by SIGTERM/SIGINT
+
+    SolutionCache *cache;               // constructed-solution hash -> local search result (nullptr = off)
+    vector<int> cachedSolution;         // reusable lookup buffer
+
+    IteratedLocalSearch *ils;           // intensification on the global best (nullptr = off)
+    double ilsFraction;                 // share of work units spent in intensification
+    long long ilsSpent;                 // work units spent in intensification
+
+    int candidateK;                     // candidate-list pool size (0 = full candidate set)
+    vector<int> candidateOrder;         // nodes ranked by static score, rebuilt every iteration
+    vector<float> candidateScore;       // static score of each node
+    vector<int> candidateBucket;        // scratch: score bucket of each node past the top candidateK
+
+    BatchConstructor *batch;            // lockstep construction of up to 64 ants (nullptr = off)
+    vector<vector<int>> batchSolutions; // constructions of the current batch
+
+    PhaseCounters *perf;                // hardware counters per iteration phase (nullptr = off)
+
+    // Convergence control
+    double pBest;                       // adaptive bounds: tau_max/tau_min from the global best (0 = fixed bounds)
+    bool boundsDerived;                 // the adaptive bounds have replaced the fixed ones
+    double restartBranching;            // restart when active nodes < restartBranching * best size (0 = off)
+    int restartWait;                    // ... and the restart best has not improved for this many iterations
+    bool depositSchedule;               // interleave restart/global-best deposits with iteration-best ones
+    int restart_best_size;              // best size since the last restart
+    vector<int> restart_best_solution;  // best nodes since the last restart
+    int lastRestart;                    // iteration of the last restart (0 = none)
+    int lastImprovement;                // iteration of the last restart-best improvement
+
+    int degThreads;                     // threads for degeneracy rebuilds after edge batches
+
+    MMASSolver(NeighList *nl, int m, float alpha, float beta, float gamma, float delta, float rho,
+               float tau_min = 1.0f, float tau_max = 100.0f, int ls_budget = 1, bool verbose = false,
+               unsigned int seed = 1)
+     : pheromones(nl->n, rho, tau_min, tau_max), rng(seed) {
+        this->nl = nl;
+        this->m = m;
+        this->alpha = alpha;
+        this->beta = beta;
+        this->gamma = gamma;
+        this->delta = delta;
+        this->ls_budget = ls_budget;
+        this->verbose = verbose;
+        global_best_size = 0;
+        iterations = 0;
+        elapsed = 0.0;
+        work = 0;
+        checkpointWriter = nullptr;
+        checkpointInterval = 0.0;
+        lastCheckpoint = 0.0;
+        interrupted = false;
+        cache = nullptr;
+        ils = nullptr;
+        ilsFraction = 0.0;
+        ilsSpent = 0;
+        candidateK = 0;
+        batch = nullptr;
+        perf = nullptr;
+        pBest = 0.0;
+        boundsDerived = false;
+        restartBranching = 0.0;
+        restartWait = 0;
+        depositSchedule = false;
+        restart_best_size = 0;
+        lastRestart = 0;
+        lastImprovement = 0;
+        degThreads = 1;
+
+        if (gamma != 0.0f) {
+            // Ensure degeneracy is computed
+            if (nl->degeneracy == nullptr) {
+                nl->buildDegeneracy();
+            }
+        }
+
+        // Create colony of m ants
+        for (int i = 0; i < m; i++) {
+            colony.push_back(new Ant(nl, &pheromones, alpha, beta, gamma, delta, &rng, i > 0 ? colony[0] : nullptr));
+        }
+    }
 
-    if (gamma != 0.0f) {
-        // Ensure degeneracy is computed
-        if (nl->degeneracy == nullptr) {
-            nl->buildDegeneracy();
+    ~MMASSolver() {
+        for (Ant* ant : colony) {
+            delete ant;
         }
+        // Joins the writer after the last submitted checkpoint is on disk
+        if (checkpointWriter) delete checkpointWriter;
+        if (cache) delete cache;
+        if (ils) delete ils;
+        if (batch) delete batch;
+        if (perf) delete perf;
     }
 
-    auto start_time = chrono::high_resolution_clock::now();
+    /*
+        enablePerfCounters: count hardware events separately for the construction,
+        local search (including intensification) and pheromone update phases of
+        solve(). Returns false, leaving counting off, if no counter can be opened.
+    */
+    bool enablePerfCounters() {
+        if (perf) delete perf;
+        perf = new PhaseCounters();
+        if (!perf->anyAvailable()) {
+            delete perf;
+            perf = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    /*
+        enableBatchConstruction: ants construct in lockstep groups of size
+        (at most 64) sharing one pass over the graph per step, see
+        BatchConstructor. Exact completion and candidate lists do not apply.
+    */
+    void enableBatchConstruction(int size) {
+        if (batch) delete batch;
+        batch = new BatchConstructor(nl, size, alpha, &rng);
+    }
 
-    int it = 0;
-    if (iterations == nullptr) {
-        iterations = &it;
+    /*
+        enableIntensification: after every colony iteration, run iterated local
+        search on the global best until it has used fraction of all work units
+        (a deterministic stand-in for a share of the time budget). strength is
+        the number of nodes force-inserted per perturbation.
+        Returns false, leaving intensification off, unless fraction is in [0, 1)
+        and strength is positive.
+    */
+    bool enableIntensification(double fraction, int strength) {
+        if (!(fraction >= 0.0 && fraction < 1.0) || strength <= 0) {
+            fprintf(stderr, "Error: ILS fraction must be in [0, 1) and strength positive\n");
+            return false;
+        }
+        if (ils) delete ils;
+        ils = new IteratedLocalSearch(nl, &rng, strength);
+        ilsFraction = fraction;
+        return true;
     }
 
-    // MMAS: Initialize pheromone array with tau_min and tau_max bounds
-    pheromoneArray pheromones(nl->n, rho, tau_min, tau_max);
+    /*
+        intensify: ILS phase restarted from the global best, so it carries no
+        state between iterations. Returns true if it improved the global best.
+    */
+    bool intensify() {
+        if (global_best_solution.empty()) return false;
 
-    int global_best_size = 0;
-    vector<int> global_best_solution;
+        long long before = ils->totalWork();
+        ils->reset(global_best_solution);
+        while (ils->totalWork() - before + ilsSpent < ilsFraction * (work + ils->totalWork() - before)) {
+            ils->step();
+        }
+        long long spent = ils->totalWork() - before;
+        work += spent;
+        ilsSpent += spent;
 
-    // Create colony of m ants
-    vector<Ant*> colony;
-    for (int i = 0; i < m; i++) {
-        colony.push_back(new Ant(nl, &pheromones, alpha, beta, gamma, delta));
+        if ((int)ils->best.size() > global_best_size) {
+            global_best_size = ils->best.size();
+            global_best_solution = ils->best;
+            if (verbose) printf("New best size: %d at iteration %d (intensification)\n", global_best_size, iterations);
+            return true;
+        }
+        return false;
     }
-    
-    while (chrono::duration<double>(chrono::high_resolution_clock::now() - start_time).count() < time_limit) {
-        
-        int iteration_best_size = 0;
-        int iteration_best_ant = 0;
-        
-        // Each ant constructs a solution
-        for (int i = 0; i < m; i++) {
-            int size = colony[i]->constructSolution();
-            
-            // Apply local search
-            if (ls_budget > 0) {
-                localSearch(colony[i]->sol, ls_budget);
-                size = colony[i]->sol->size();
+
+    /*
+        enableAdaptiveBounds: derive the pheromone bounds from the global best
+        instead of fixed values (Stuetzle and Hoos): tau_max = f(best) / rho, with
+        f(best) the best size (the deposit amount), and tau_min chosen so that a
+        converged trail still builds the best solution with probability p_best.
+    */
+    void enableAdaptiveBounds(double p_best = 0.05) {
+        pBest = p_best;
+        updateBounds();
+    }
+
+    /*
+        updateBounds: recompute tau_max/tau_min from the global best size.
+        A construction takes about |best| decisions among n/2 candidates on
+        average ((k + 1)/2 with candidate lists of size k). The first derived
+        bounds restart the trail at tau_max; later changes clamp it into range.
+    */
+    void updateBounds() {
+        if (pBest <= 0.0 || global_best_size == 0) return;
+
+        double tau_max = global_best_size / pheromones.evaporation_rate;
+        double pDec = pow(pBest, 1.0 / global_best_size);
+        double avg = candidateK > 0 ? (min(candidateK, nl->n) + 1) / 2.0 : nl->n / 2.0;
+        double tau_min = avg > 1.0 ? tau_max * (1.0 - pDec) / ((avg - 1.0) * pDec) : tau_max / 2.0;
+        if (tau_min >= tau_max) tau_min = tau_max / 2.0;
+        if ((float)tau_max == pheromones.tau_max && (float)tau_min == pheromones.tau_min) return;
+
+        pheromones.tau_max = tau_max;
+        pheromones.tau_min = tau_min;
+        if (boundsDerived) {
+            pheromones.clamp();
+        } else {
+            pheromones.reinitialize();
+            boundsDerived = true;
+        }
+    }
+
+    /*
+        enableRestarts: reinitialize the pheromones to tau_max once the trail has
+        converged (fewer than branching * best size active nodes, see
+        pheromoneArray::evaporate) and the best solution since the last restart
+        has not improved for wait iterations.
+    */
+    void enableRestarts(double branching, int wait) {
+        restartBranching = branching;
+        restartWait = wait;
+    }
+
+    /*
+        enableDepositSchedule: the iteration-best ant deposits by default; every
+        u-th iteration since the last restart the restart-best solution deposits
+        instead, alternating with the global best. u shrinks as the run ages
+        (25, 5, 3, 2, then every iteration), shifting from exploration to exploitation.
+    */
+    void enableDepositSchedule() {
+        depositSchedule = true;
+    }
+
+    // Iterations between best-so-far deposits, by iterations since the last restart
+    static int depositInterval(int age) {
+        if (age < 25) return 25;
+        if (age < 75) return 5;
+        if (age < 125) return 3;
+        if (age < 250) return 2;
+        return 1;
+    }
+
+    // Record a solution as the best since the last restart if it is larger
+    void trackRestartBest(const vector<int>& solution) {
+        if ((int)solution.size() > restart_best_size) {
+            restart_best_size = solution.size();
+            restart_best_solution = solution;
+            lastImprovement = iterations;
+        }
+    }
+
+    // restart: reinitialize the trail and start a new restart-best
+    void restart() {
+        pheromones.reinitialize();
+        restart_best_size = 0;
+        restart_best_solution.clear();
+        lastRestart = iterations;
+        lastImprovement = iterations;
+        if (verbose) printf("Pheromone restart at iteration %d\n", iterations);
+    }
+
+    // enableExactCompletion: see Ant::enableExactCompletion
+    void enableExactCompletion(int threshold, long long nodeLimit = 100000) {
+        for (Ant* ant : colony) {
+            ant->enableExactCompletion(threshold, nodeLimit);
+        }
+    }
+
+    /*
+        enableCandidateList: ants sample from a pool of the k best-ranked valid
+        nodes instead of every valid node (see Ant::constructSolutionPooled).
+    */
+    void enableCandidateList(int k) {
+        candidateK = k;
+        for (Ant* ant : colony) {
+            ant->candidateK = k;
+            ant->candidateOrder = &candidateOrder;
+            ant->candidateScore = &candidateScore;
+        }
+    }
+
+    // Log-scale score buckets used to rank the nodes past the top candidateK
+    static const int CANDIDATE_BUCKETS = 256;
+
+    /*
+        buildCandidateOrder: ranks nodes by pheromones^alpha * degree * degeneracy
+        heuristics. Ants copy the global pheromones at reset, so one ranking
+        serves the whole colony for an iteration.
+        The top candidateK nodes are selected and sorted exactly (ties by node id),
+        O(n log k). Pool refills read on past them, so the remaining nodes are
+        ranked by a stable counting sort on CANDIDATE_BUCKETS log-scale score
+        buckets, O(n): order within a bucket is by node id.
+    */
+    void buildCandidateOrder() {
+        Ant *ant = colony[0];
+        int n = nl->n;
+        candidateScore.resize(n);
+        candidateOrder.resize(n);
+        for (int i = 0; i < n; i++) {
+            candidateScore[i] = powf(pheromones.getPheromone(i), alpha) * ant->degreeHeuristic(i) * ant->degeneracyHeuristic(i);
+            candidateOrder[i] = i;
+        }
+        int k = min(candidateK, n);
+        std::partial_sort(candidateOrder.begin(), candidateOrder.begin() + k, candidateOrder.end(), [this](int a, int b) {
+            return candidateScore[a] > candidateScore[b] || (candidateScore[a] == candidateScore[b] && a < b);
+        });
+        work += (long long)n * (int)ceil(log2(k + 1.0));
+
+        // Bucket the tail by log score, highest bucket first; top-k nodes are marked -1
+        if (n - k < 2) return;
+        candidateBucket.assign(n, 0);
+        for (int i = 0; i < k; i++) candidateBucket[candidateOrder[i]] = -1;
+        float lo = INFINITY, hi = -INFINITY;
+        for (int node = 0; node < n; node++) {
+            if (candidateBucket[node] < 0) continue;
+            float l = log2f(candidateScore[node] + FLT_MIN);
+            lo = min(lo, l);
+            hi = max(hi, l);
+        }
+        float scale = hi > lo ? (CANDIDATE_BUCKETS - 1) / (hi - lo) : 0.0f;
+        int count[CANDIDATE_BUCKETS + 1] = {0};
+        for (int node = 0; node < n; node++) {
+            if (candidateBucket[node] < 0) continue;
+            int b = CANDIDATE_BUCKETS - 1 - (int)((log2f(candidateScore[node] + FLT_MIN) - lo) * scale);
+            candidateBucket[node] = b;
+            count[b + 1]++;
+        }
+        for (int b = 0; b < CANDIDATE_BUCKETS; b++) count[b + 1] += count[b];
+        for (int node = 0; node < n; node++) {
+            if (candidateBucket[node] >= 0) candidateOrder[k + count[candidateBucket[node]]++] = node;
+        }
+        work += 2 * (n - k);
+    }
+
+    /*
+        enableSolutionCache: skip local search for constructions identical to a
+        recent one, reusing its result. capacity bounds the number of entries.
+    */
+    void enableSolutionCache(size_t capacity) {
+        if (nl->zobrist == nullptr) nl->buildZobrist();
+        if (cache) delete cache;
+        cache = new SolutionCache(capacity);
+        // Ants built before the keys existed have unhashed solutions
+        for (Ant* ant : colony) {
+            ant->reset();
+        }
+    }
+
+    /*
+        enableCheckpoints: write a checkpoint to path every interval seconds
+        (0 = only when signalled) and at the end of every solve().
+    */
+    void enableCheckpoints(const char *path, double interval) {
+        if (checkpointWriter) delete checkpointWriter;
+        checkpointWriter = new CheckpointWriter(path);
+        checkpointInterval = interval;
+        lastCheckpoint = elapsed;
+    }
+
+    // snapshot: copy the run state into ckpt (reusing its buffers)
+    void snapshot(Checkpoint &ckpt, double elapsed_now) {
+        ckpt.n = nl->n;
+        ckpt.iterations = iterations;
+        ckpt.elapsed = elapsed_now;
+        ckpt.work = work;
+        ckpt.ils_spent = ilsSpent;
+        ckpt.best_solution = global_best_solution;
+        ckpt.pheromones.assign(pheromones.pheromones, pheromones.pheromones + nl->n);
+        ckpt.tau_min = pheromones.tau_min;
+        ckpt.tau_max = pheromones.tau_max;
+        ckpt.restart_best_solution = restart_best_solution;
+        ckpt.last_restart = lastRestart;
+        ckpt.last_improvement = lastImprovement;
+        std::ostringstream os;
+        os << rng;
+        ckpt.rng_state = os.str();
+    }
+
+    /*
+        restore: continue from a checkpoint taken on the same graph. Returns false,
+        leaving the solver unchanged, if the checkpoint is incompatible or corrupt.
+    */
+    bool restore(const Checkpoint &ckpt) {
+        // Validate everything before the solver state is touched
+        if (ckpt.n != nl->n || (int)ckpt.pheromones.size() != nl->n) {
+            fprintf(stderr, "Error: Checkpoint has %d nodes, graph has %d\n", ckpt.n, nl->n);
+            return false;
+        }
+        if (!validSolution(ckpt.best_solution) || !validSolution(ckpt.restart_best_solution)) {
+            return false;
+        }
+        if (!(ckpt.tau_min > 0.0f && ckpt.tau_min < ckpt.tau_max)) {
+            fprintf(stderr, "Error: Checkpoint has invalid pheromone bounds\n");
+            return false;
+        }
+        std::mt19937 restored;
+        std::istringstream is(ckpt.rng_state);
+        is >> restored;
+        if (is.fail()) {
+            fprintf(stderr, "Error: Checkpoint has an invalid random generator state\n");
+            return false;
+        }
+
+        rng = restored;
+        memcpy(pheromones.pheromones, ckpt.pheromones.data(), nl->n * sizeof(float));
+        pheromones.tau_min = ckpt.tau_min;
+        pheromones.tau_max = ckpt.tau_max;
+        iterations = ckpt.iterations;
+        elapsed = ckpt.elapsed;
+        work = ckpt.work;
+        ilsSpent = ckpt.ils_spent;
+        lastCheckpoint = elapsed;
+        global_best_solution = ckpt.best_solution;
+        global_best_size = global_best_solution.size();
+        restart_best_solution = ckpt.restart_best_solution;
+        restart_best_size = restart_best_solution.size();
+        lastRestart = ckpt.last_restart;
+        lastImprovement = ckpt.last_improvement;
+        // A checkpoint is taken after updateBounds(), so a run with a best already has derived bounds
+        boundsDerived = pBest > 0.0 && global_best_size > 0;
+
+        for (Ant* ant : colony) {
+            ant->reset();
+        }
+        return true;
+    }
+
+    // validSolution: true if nodes are distinct nodes of the graph and pairwise non-adjacent
+    bool validSolution(const vector<int>& nodes) {
+        vector<char> inSet(nl->n, 0);
+        for (int node : nodes) {
+            if (node < 0 || node >= nl->n || inSet[node]) {
+                fprintf(stderr, "Error: Checkpoint solution has invalid or repeated node %d\n", node);
+                return false;
+            }
+            inSet[node] = 1;
+        }
+        for (int node : nodes) {
+            for (int neighbor : nl->neighbors(node)) {
+                if (inSet[neighbor]) {
+                    fprintf(stderr, "Error: Checkpoint solution is not independent (%d, %d)\n", node, neighbor);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Submit a checkpoint to the background writer
+    void writeCheckpoint(double elapsed_now) {
+        snapshot(snapshotBuffer, elapsed_now);
+        checkpointWriter->submit(snapshotBuffer);
+        lastCheckpoint = elapsed_now;
+    }
+
+    // Iterations between wall-clock checks when a deterministic budget is set
+    static const int TIME_CHECK_INTERVAL = 16;
+
+    /*
+        solve: runs MMAS iterations, continuing from the current pheromones and
+        incumbent. Returns the best size found so far.
+        - time_budget: seconds of wall-clock time (<= 0 = no limit if a deterministic budget is set)
+        - iteration_budget: maximum iterations in this call (0 = no limit)
+        - work_budget: maximum work units in this call (0 = no limit)
+        With a deterministic budget the run depends only on the seed; the wall
+        clock is then a secondary guard checked every TIME_CHECK_INTERVAL iterations.
+    */
+    int solve(double time_budget, int iteration_budget = 0, long long work_budget = 0) {
+        auto start_time = chrono::high_resolution_clock::now();
+        interrupted = false;
+
+        bool deterministic = iteration_budget > 0 || work_budget > 0;
+        int start_iterations = iterations;
+        long long start_work = work;
+
+        for (int it = 0; ; it++) {
+            if (iteration_budget > 0 && iterations - start_iterations >= iteration_budget) break;
+            if (work_budget > 0 && work - start_work >= work_budget) break;
+            if (!deterministic || (time_budget > 0 && it % TIME_CHECK_INTERVAL == 0)) {
+                if (chrono::duration<double>(chrono::high_resolution_clock::now() - start_time).count() >= time_budget) {
+                    if (verbose && deterministic) printf("Stopped by the wall-clock guard at iteration %d\n", iterations);
+                    break;
+                }
+            }
+
+            int iteration_best_size = 0;
+
+            if (perf) perf->start(PhaseCounters::CONSTRUCTION);
+            if (candidateK > 0) {
+                buildCandidateOrder();
+            }
+            if (perf) perf->stop(PhaseCounters::CONSTRUCTION);
+
+            // Each ant constructs a solution
+            for (int i = 0; i < m; i++) {
+                const vector<int> *nodes = &colony[i]->sol->solution;    // the ant's final solution
+                if (perf) perf->start(PhaseCounters::CONSTRUCTION);
+                if (batch) {
+                    // Construct the next group of ants together, then hand each its set
+                    if (i % batch->B == 0) {
+                        long long before = batch->work;
+                        batch->construct(min(batch->B, m - i), pheromones, colony[i], batchSolutions);
+                        work += batch->work - before;
+                    }
+                    nodes = &batchSolutions[i % batch->B];
+                    // Only local search needs the ant's tightness state; without it the set is used as is
+                    if (ls_budget > 0) colony[i]->loadSolution(*nodes);
+                } else {
+                    colony[i]->constructSolution();
+                }
+                if (perf) perf->stop(PhaseCounters::CONSTRUCTION);
+
+                if (!batch || ls_budget > 0) {
+                    // Apply local search, or reuse the result cached for an identical construction
+                    if (ls_budget > 0) {
+                        if (perf) perf->start(PhaseCounters::LOCAL_SEARCH);
+                        uint64_t key = colony[i]->sol->hash;
+                        if (cache && cache->lookup(key, cachedSolution)) {
+                            colony[i]->loadSolution(cachedSolution);
+                        } else {
+                            localSearch(colony[i]->sol, ls_budget);
+                            if (cache) cache->insert(key, colony[i]->sol->solution);
+                        }
+                        if (perf) perf->stop(PhaseCounters::LOCAL_SEARCH);
+                    }
+                    nodes = &colony[i]->sol->solution;
+                    work += colony[i]->sol->work;
+                }
+                int size = nodes->size();
+
+                // Track iteration best
+                if (size > iteration_best_size) {
+                    iteration_best_size = size;
+                    iteration_best_solution = *nodes;
+                }
+
+                // Track global best
+                if (size > global_best_size) {
+                    global_best_size = size;
+                    global_best_solution = *nodes;
+
+                    if (verbose) printf("New best size: %d at iteration %d\n", global_best_size, iterations);
+                }
+                if (size > restart_best_size) trackRestartBest(*nodes);
             }
-            
-            // Track iteration best
-            if (size > iteration_best_size) {
-                iteration_best_size = size;
-                iteration_best_ant = i;
+
+            // Intensification (counted as local search)
+            if (perf && ils) perf->start(PhaseCounters::LOCAL_SEARCH);
+            bool intensified = ils && intensify();
+            if (intensified) trackRestartBest(global_best_solution);
+            if (perf && ils) perf->stop(PhaseCounters::LOCAL_SEARCH);
+
+            if (perf) perf->start(PhaseCounters::PHEROMONE);
+
+            updateBounds();
+
+            // MMAS: Only the iteration-best ant deposits pheromones
+            // (or, on the schedule, the restart-best / global-best solution)
+            // Deposit amount = 1/f(s) where f(s) is solution quality
+            // For MISP, we want larger sets, so deposit amount = solution_size
+            int age = iterations - lastRestart;
+            int interval = depositInterval(age);
+            if (depositSchedule && age % interval == 0) {
+                const vector<int> &best = (age / interval) % 2 == 0 ? restart_best_solution : global_best_solution;
+                for (int node : best) {
+                    pheromones.deposit(node, static_cast<float>(best.size()));
+                }
+            } else {
+                float deposit_amount = static_cast<float>(iteration_best_size);
+                for (int node : iteration_best_solution) {
+                    pheromones.deposit(node, deposit_amount);
+                }
             }
-            
-            // Track global best
-            if (size > global_best_size) {
-                global_best_size = size;
-                global_best_solution = colony[i]->sol->solution;
-                
-                if (verbose) printf("New best size: %d at iteration %d\n", global_best_size, *iterations);
+
+            // Intensification improvements are reinforced as a global-best deposit
+            if (intensified) {
+                for (int node : global_best_solution) {
+                    pheromones.deposit(node, static_cast<float>(global_best_size));
+                }
+            }
+
+            // Evaporate pheromones
+            pheromones.evaporate();
+
+            // Restart once the trail has converged and the restart best stagnates
+            if (restartBranching > 0.0 && pheromones.active < restartBranching * global_best_size
+                && iterations - lastImprovement >= restartWait) {
+                restart();
+            }
+
+            // Reset all ants for next iteration (copies the evaporated pheromones);
+            // batch construction without local search does not use the ants' state
+            if (!batch || ls_budget > 0) {
+                for (int i = 0; i < m; i++) {
+                    colony[i]->reset();
+                }
+            }
+
+            if (perf) perf->stop(PhaseCounters::PHEROMONE);
+
+            iterations++;
+
+            // Checkpoint at the iteration boundary when due or signalled
+            if (checkpointWriter) {
+                double now = elapsed + chrono::duration<double>(chrono::high_resolution_clock::now() - start_time).count();
+                bool stop = stopSignal != 0;
+                if (stop || checkpointSignal || (checkpointInterval > 0.0 && now - lastCheckpoint >= checkpointInterval)) {
+                    checkpointSignal = 0;
+                    writeCheckpoint(now);
+                }
+                if (stop) {
+                    interrupted = true;
+                    break;
+                }
             }
         }
-        
-        // MMAS: Only the iteration-best ant deposits pheromones
-        // Deposit amount = 1/f(s) where f(s) is solution quality
-        // For MISP, we want larger sets, so deposit amount = solution_size
-        float deposit_amount = static_cast<float>(iteration_best_size);
-        colony[iteration_best_ant]->depositInSolution(deposit_amount);
-        
-        // Reset all ants for next iteration
-        for (int i = 0; i < m; i++) {
-            colony[i]->reset();
+
+        elapsed += chrono::duration<double>(chrono::high_resolution_clock::now() - start_time).count();
+        if (checkpointWriter && !interrupted) {
+            writeCheckpoint(elapsed);
         }
-        
-        // Evaporate pheromones
-        pheromones.evaporate();
 
-        (*iterations)++;
+        if (verbose) printf("Best size found: %d in %d iterations\n", global_best_size, iterations);
+        if (verbose && cache) {
+            printf("Solution cache: %lld/%lld hits (%.1f%%)\n", (long long)cache->hits, (long long)cache->lookups, 100.0 * cache->hitRate());
+        }
+
+        return global_best_size;
     }
 
-    if (verbose) printf("Best size found: %d in %d iterations\n", global_best_size, *iterations);
+    /*
+        insertEdges / deleteEdges: apply an edge batch to the graph, refresh the
+        graph-dependent heuristics and repair the incumbent. Pheromones are kept.
+        Return the number of edges actually inserted / deleted.
+    */
+    int insertEdges(const vector<pair<int, int>>& edges) {
+        int changed = nl->addEdges(edges);
+        if (changed > 0) graphChanged();
+        return changed;
+    }
+
+    int deleteEdges(const vector<pair<int, int>>& edges) {
+        int changed = nl->removeEdges(edges);
+        if (changed > 0) graphChanged();
+        return changed;
+    }
+
+    /*
+        setDegeneracyThreads: threads used when an edge batch invalidates the node
+        degeneracy (see NeighList::buildDegeneracy; 1 = sequential).
+    */
+    void setDegeneracyThreads(int threads) {
+        degThreads = threads;
+    }
+
+    void graphChanged() {
+        if (gamma != 0.0f && nl->degeneracy == nullptr) {
+            nl->buildDegeneracy(degThreads);
+        }
+        if (cache) cache->clear();
+        // The first ant owns the heuristic arrays, the others point to them
+        colony[0]->buildHeuristics();
+        for (Ant* ant : colony) {
+            if (ant != colony[0]) ant->shareHeuristics(colony[0]);
+            ant->reset();
+        }
+        repairBest();
+        if (restart_best_size > 0) {
+            restart_best_solution = global_best_solution;
+            restart_best_size = global_best_size;
+        }
+    }
+
+    /*
+        repairBest: rebuilds the incumbent on the current graph. Nodes that became
+        adjacent to an earlier incumbent node are dropped, then local search
+        refills the solution (also picking up nodes freed by deleted edges).
+    */
+    void repairBest() {
+        MISP_Solution sol(nl);
+        for (int node : global_best_solution) {
+            if (sol.MISP_IndependentDegree[node] == 0) {
+                sol.addNode(node);
+            }
+        }
+        localSearch(&sol, ls_budget > 0 ? ls_budget : 1);
+
+        if (verbose && sol.size() != global_best_size) {
+            printf("Incumbent repaired: %d -> %d\n", global_best_size, sol.size());
+        }
+        global_best_size = sol.size();
+        global_best_solution = sol.solution;
+    }
+};
+
+/*
+    MMAS (Max-Min Ant System) for Maximum Independent Set Problem.
+    Single cold run of MMASSolver; see MMASSolver and MMASSolver::solve for the parameters.
+*/
+int MMAS(NeighList *nl, double time_limit, int m, float alpha, float beta, float gamma, float delta, float rho,
+         float tau_min = 1.0f, float tau_max = 100.0f, int ls_budget = 1,
+         bool verbose = false, int *iterations = nullptr, unsigned int seed = 1,
+         int max_iterations = 0, long long max_work = 0) {
+
+    MMASSolver solver(nl, m, alpha, beta, gamma, delta, rho, tau_min, tau_max, ls_budget, verbose, seed);
+
+    int best = solver.solve(time_limit, max_iterations, max_work);
 
-    // Cleanup
-    for (Ant* ant : colony) {
-        delete ant;
+    if (iterations != nullptr) {
+        *iterations = solver.iterations;
     }
 
-    return global_best_size;
-}
\ No newline at end of file
+    return best;
+}
@@ -2,116 +2,534 @@
 
 #include <vector>
 #include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <atomic>
+#include <thread>
 using std::vector;
 
+// Forward iterator over a node's neighbors.
+// Reads plain int storage, or decodes delta-encoded varints when the list is compressed.
+struct NeighIterator {
+    const int *ip;          // cursor into plain storage (nullptr when compressed)
+    const uint8_t *bp;      // cursor into compressed storage (nullptr when plain)
+    int left;               // neighbors left to visit (0 = end)
+    int cur;                // current neighbor
+
+    NeighIterator(const int *ip, const uint8_t *bp, int left) : ip(ip), bp(bp), left(left), cur(0) {
+        if (left > 0) {
+            if (bp) decode();
+            else cur = *ip;
+        }
+    }
+
+    // Read one LEB128 varint gap and advance to the next neighbor id
+    void decode() {
+        uint32_t gap = *bp++;
+        if (gap & 0x80) {
+            gap &= 0x7f;
+            int shift = 7;
+            uint8_t byte;
+            do {
+                byte = *bp++;
+                gap |= (uint32_t)(byte & 0x7f) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+        }
+        cur += gap;
+    }
+
+    int operator*() const { return cur; }
+
+    NeighIterator& operator++() {
+        if (--left > 0) {
+            if (bp) decode();
+            else cur = *++ip;
+        }
+        return *this;
+    }
+
+    bool operator!=(const NeighIterator& other) const { return left != other.left; }
+    bool operator==(const NeighIterator& other) const { return left == other.left; }
+};
+
+// Range over a node's neighbors, usable in range-based for loops
+struct NeighRange {
+    const int *ip;
+    const uint8_t *bp;
+    int count;
+
+    NeighRange(const int *ip, const uint8_t *bp, int count) : ip(ip), bp(bp), count(count) {}
+
+    NeighIterator begin() const { return NeighIterator(ip, bp, count); }
+    NeighIterator end() const { return NeighIterator(nullptr, nullptr, 0); }
+    int size() const { return count; }
+};
+
 // Neighborhood List
 struct NeighList {
     int n;
     int *degrees;
-    vector<int> *neighborhoods;
+    vector<int> *neighborhoods;     // plain adjacency (nullptr once compressed)
+    uint8_t *adjBytes;              // compressed adjacency: sorted, delta-encoded varints (nullptr if plain)
+    size_t *adjOffset;              // start of each node's list in adjBytes (n + 1 entries)
     int *degeneracy;      // degeneracy of each node (computed on demand)
     int maxDegeneracy;    // graph degeneracy (max node degeneracy)
+    uint64_t *zobrist;    // random 64-bit key of each node for set hashing (computed on demand)
 
     NeighList(int n) {
         this->n = n;
         degrees = new int[n];
         neighborhoods = new vector<int>[n];
+        adjBytes = nullptr;
+        adjOffset = nullptr;
         degeneracy = nullptr;
         maxDegeneracy = 0;
+        zobrist = nullptr;
         for (int i = 0; i < n; i++) {
             degrees[i] = 0;
         }
     }
     ~NeighList() {
         delete[] degrees;
-        delete[] neighborhoods;
+        if (neighborhoods) delete[] neighborhoods;
+        if (adjBytes) delete[] adjBytes;
+        if (adjOffset) delete[] adjOffset;
         if (degeneracy) delete[] degeneracy;
+        if (zobrist) delete[] zobrist;
+    }
+
+    bool isCompressed() const {
+        return adjBytes != nullptr;
     }
 
+    // Add v to the neighborhood of u (plain storage only, i.e. before compress())
     void push(int u, int v) {
         neighborhoods[u].push_back(v);
         degrees[u]++;
     }
 
+    /*
+        addEdge / removeEdge: insert or delete the undirected edge (u, v).
+        Compressed lists of u and v are re-encoded in place, the rest of the
+        graph stays compressed. The node degeneracy is invalidated and must be
+        rebuilt if needed.
+        Return false if an endpoint is out of range, u == v, or the edge
+        already exists / does not exist.
+    */
+    bool addEdge(int u, int v) {
+        if (!validEdge(u, v) || isNeighbor(u, v)) return false;
+        if (adjBytes) {
+            insertCompressed(u, v);
+            insertCompressed(v, u);
+        } else {
+            push(u, v);
+            push(v, u);
+        }
+        invalidateDegeneracy();
+        return true;
+    }
+
+    bool removeEdge(int u, int v) {
+        if (!validEdge(u, v) || !isNeighbor(u, v)) return false;
+        if (adjBytes) {
+            eraseCompressed(u, v);
+            eraseCompressed(v, u);
+        } else {
+            eraseFrom(u, v);
+            eraseFrom(v, u);
+        }
+        invalidateDegeneracy();
+        return true;
+    }
+
+    /*
+        addEdges / removeEdges: apply a batch of edge insertions / deletions.
+        A compressed graph is expanded once for the whole batch and compressed
+        again afterwards, instead of re-encoding the buffer for every edge.
+        Return the number of edges actually inserted / deleted.
+    */
+    int addEdges(const vector<std::pair<int, int>>& edges) {
+        bool compressed = isCompressed();
+        if (compressed && edges.size() > 1) decompress();
+        int changed = 0;
+        for (const std::pair<int, int>& e : edges) {
+            if (addEdge(e.first, e.second)) changed++;
+        }
+        if (compressed) compress();
+        return changed;
+    }
+
+    int removeEdges(const vector<std::pair<int, int>>& edges) {
+        bool compressed = isCompressed();
+        if (compressed && edges.size() > 1) decompress();
+        int changed = 0;
+        for (const std::pair<int, int>& e : edges) {
+            if (removeEdge(e.first, e.second)) changed++;
+        }
+        if (compressed) compress();
+        return changed;
+    }
+
+    bool validEdge(int u, int v) const {
+        return u >= 0 && u < n && v >= 0 && v < n && u != v;
+    }
+
+    // Remove v from the plain neighborhood of u (swap and pop)
+    void eraseFrom(int u, int v) {
+        vector<int> &nb = neighborhoods[u];
+        auto found = std::find(nb.begin(), nb.end(), v);
+        if (found != nb.end()) {
+            *found = nb.back();
+            nb.pop_back();
+            degrees[u]--;
+        }
+    }
+
+    // Add v to the compressed neighborhood of u
+    void insertCompressed(int u, int v) {
+        vector<int> nb;
+        nb.reserve(degrees[u] + 1);
+        for (int w : neighbors(u)) nb.push_back(w);
+        nb.insert(std::lower_bound(nb.begin(), nb.end(), v), v);
+        replaceCompressed(u, nb);
+    }
+
+    // Remove v from the compressed neighborhood of u
+    void eraseCompressed(int u, int v) {
+        vector<int> nb;
+        nb.reserve(degrees[u]);
+        for (int w : neighbors(u)) {
+            if (w != v) nb.push_back(w);
+        }
+        replaceCompressed(u, nb);
+    }
+
+    /*
+        replaceCompressed: re-encodes the compressed neighborhood of u as the sorted
+        list nb. The buffer is rebuilt around u's bytes and later offsets are shifted,
+        O(n + encoded size) without expanding any other list.
+    */
+    void replaceCompressed(int u, const vector<int>& nb) {
+        size_t oldSize = adjOffset[u + 1] - adjOffset[u];
+        size_t newSize = encodedSize(nb);
+        size_t total = adjOffset[n] - oldSize + newSize;
+
+        uint8_t *bytes = new uint8_t[total > 0 ? total : 1];
+        memcpy(bytes, adjBytes, adjOffset[u]);
+        uint8_t *tail = encode(bytes + adjOffset[u], nb);
+        memcpy(tail, adjBytes + adjOffset[u + 1], adjOffset[n] - adjOffset[u + 1]);
+        delete[] adjBytes;
+        adjBytes = bytes;
+
+        for (int w = u + 1; w <= n; w++) {
+            adjOffset[w] = adjOffset[w] - oldSize + newSize;
+        }
+        degrees[u] = nb.size();
+    }
+
+    void invalidateDegeneracy() {
+        if (degeneracy) delete[] degeneracy;
+        degeneracy = nullptr;
+        maxDegeneracy = 0;
+    }
+
+    // Neighbors of u, regardless of the storage format
+    NeighRange neighbors(int u) const {
+        if (adjBytes) return NeighRange(nullptr, adjBytes + adjOffset[u], degrees[u]);
+        return NeighRange(neighborhoods[u].data(), nullptr, degrees[u]);
+    }
+
     bool isNeighbor(int u, int v) {
-        for (int neighbor : neighborhoods[u]) {
+        for (int neighbor : neighbors(u)) {
             if (neighbor == v) {
                 return true;
             }
+            // compressed lists are sorted
+            if (adjBytes && neighbor > v) {
+                return false;
+            }
         }
         return false;
     }
 
-    // Compute degeneracy for all nodes using the peeling algorithm O(n + m)
-    void buildDegeneracy() {
+    static int varintSize(uint32_t x) {
+        int size = 1;
+        while (x >= 0x80) {
+            x >>= 7;
+            size++;
+        }
+        return size;
+    }
+
+    // Encoded size of a sorted neighborhood
+    static size_t encodedSize(const vector<int>& nb) {
+        size_t size = 0;
+        int prev = 0;
+        for (int v : nb) {
+            size += varintSize(v - prev);
+            prev = v;
+        }
+        return size;
+    }
+
+    // Write a sorted neighborhood as gap varints at out; returns the end of the written bytes
+    static uint8_t *encode(uint8_t *out, const vector<int>& nb) {
+        int prev = 0;
+        for (int v : nb) {
+            uint32_t gap = v - prev;
+            while (gap >= 0x80) {
+                *out++ = (uint8_t)(gap | 0x80);
+                gap >>= 7;
+            }
+            *out++ = (uint8_t)gap;
+            prev = v;
+        }
+        return out;
+    }
+
+    /*
+        compress: re-encodes every neighborhood as a sorted list of gaps stored as
+        LEB128 varints in one contiguous byte buffer. Plain vectors are released as
+        they are encoded. After this call push() is no longer available.
+    */
+    void compress() {
+        if (adjBytes) return;
+
+        // First pass: sort and measure the encoded size of each list
+        adjOffset = new size_t[n + 1];
+        size_t total = 0;
+        for (int u = 0; u < n; u++) {
+            std::sort(neighborhoods[u].begin(), neighborhoods[u].end());
+            adjOffset[u] = total;
+            total += encodedSize(neighborhoods[u]);
+        }
+        adjOffset[n] = total;
+
+        // Second pass: encode and free the plain lists
+        adjBytes = new uint8_t[total > 0 ? total : 1];
+        uint8_t *out = adjBytes;
+        for (int u = 0; u < n; u++) {
+            out = encode(out, neighborhoods[u]);
+            vector<int>().swap(neighborhoods[u]);
+        }
+
+        delete[] neighborhoods;
+        neighborhoods = nullptr;
+    }
+
+    // decompress: expands compressed adjacency back into plain vectors (no-op if plain)
+    void decompress() {
+        if (!adjBytes) return;
+
+        neighborhoods = new vector<int>[n];
+        for (int u = 0; u < n; u++) {
+            neighborhoods[u].reserve(degrees[u]);
+            for (int v : NeighRange(nullptr, adjBytes + adjOffset[u], degrees[u])) {
+                neighborhoods[u].push_back(v);
+            }
+        }
+
+        delete[] adjBytes;
+        delete[] adjOffset;
+        adjBytes = nullptr;
+        adjOffset = nullptr;
+    }
+
+    // Zobrist keys: one pseudo-random 64-bit key per node (splitmix64 stream)
+    void buildZobrist(uint64_t seed = 0x9E3779B97F4A7C15ULL) {
+        if (zobrist) delete[] zobrist;
+        zobrist = new uint64_t[n];
+        uint64_t state = seed;
+        for (int i = 0; i < n; i++) {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            zobrist[i] = z ^ (z >> 31);
+        }
+    }
+
+    // Approximate memory used by the adjacency structure, in bytes
+    size_t memoryBytes() const {
+        size_t bytes = n * sizeof(int);     // degrees
+        if (adjBytes) {
+            bytes += adjOffset[n] + (n + 1) * sizeof(size_t);
+        } else {
+            bytes += n * sizeof(vector<int>);
+            for (int u = 0; u < n; u++) bytes += neighborhoods[u].capacity() * sizeof(int);
+        }
+        return bytes;
+    }
+
+    /*
+        parallelFor: splits [0, count) into numThreads contiguous chunks and runs
+        f(thread, begin, end) on each. Small ranges run inline on the calling thread.
+    */
+    template <typename F>
+    static void parallelFor(size_t count, int numThreads, F f) {
+        if (numThreads <= 1 || count < 1024) {
+            f(0, (size_t)0, count);
+            return;
+        }
+        vector<std::thread> workers;
+        size_t chunk = (count + numThreads - 1) / numThreads;
+        for (int t = 1; t < numThreads; t++) {
+            size_t begin = t * chunk;
+            if (begin >= count) break;
+            workers.emplace_back(f, t, begin, std::min(count, begin + chunk));
+        }
+        f(0, (size_t)0, std::min(count, chunk));
+        for (std::thread &w : workers) w.join();
+    }
+
+    /*
+        buildDegeneracy: computes the core number (degeneracy) of every node and maxDegeneracy.
+        numThreads <= 1 uses the sequential Batagelj-Zaversnik peeling,
+        numThreads > 1 uses the level-synchronous parallel peeling. Both give the same result.
+    */
+    void buildDegeneracy(int numThreads = 1) {
+        if (numThreads > 1) {
+            buildDegeneracyParallel(numThreads);
+        } else {
+            buildDegeneracyBZ();
+        }
+    }
+
+    // Batagelj-Zaversnik O(n + m) peeling on flat bin/pos/vert arrays
+    void buildDegeneracyBZ() {
         if (degeneracy) delete[] degeneracy;
         degeneracy = new int[n];
-        maxDegeneracy = 0;
-
-        // Working copy of degrees
-        int *d = new int[n];
-        for (int i = 0; i < n; i++) d[i] = degrees[i];
 
-        // Find max degree for bucket allocation
+        // Residual degrees are peeled in place into core numbers
+        int *d = degeneracy;
         int maxDeg = 0;
         for (int i = 0; i < n; i++) {
+            d[i] = degrees[i];
             if (d[i] > maxDeg) maxDeg = d[i];
         }
 
-        // Bucket structure: bucket[k] = list of nodes with current degree k
-        vector<int> *bucket = new vector<int>[maxDeg + 1];
-        int *nodePos = new int[n];  // position of node in its bucket
-        
+        int *bin = new int[maxDeg + 1];  // bin[k]: first position in vert of nodes with degree k
+        int *pos = new int[n];           // pos[v]: position of v in vert
+        int *vert = new int[n];          // nodes sorted by current degree
+
+        // Counting sort of nodes by degree
+        for (int k = 0; k <= maxDeg; k++) bin[k] = 0;
+        for (int i = 0; i < n; i++) bin[d[i]]++;
+        int start = 0;
+        for (int k = 0; k <= maxDeg; k++) {
+            int count = bin[k];
+            bin[k] = start;
+            start += count;
+        }
+        for (int v = 0; v < n; v++) {
+            pos[v] = bin[d[v]];
+            vert[pos[v]] = v;
+            bin[d[v]]++;
+        }
+        for (int k = maxDeg; k > 0; k--) bin[k] = bin[k - 1];
+        bin[0] = 0;
+
+        // Peel nodes in order of current degree
         for (int i = 0; i < n; i++) {
-            nodePos[i] = bucket[d[i]].size();
-            bucket[d[i]].push_back(i);
+            int v = vert[i];
+            for (int u : neighbors(v)) {
+                if (d[u] > d[v]) {
+                    // Move u to the front of its bin, then shrink the bin past it
+                    int du = d[u];
+                    int pu = pos[u];
+                    int pw = bin[du];
+                    int w = vert[pw];
+                    if (u != w) {
+                        pos[u] = pw;
+                        vert[pu] = w;
+                        pos[w] = pu;
+                        vert[pw] = u;
+                    }
+                    bin[du]++;
+                    d[u]--;
+                }
+            }
         }
 
-        bool *removed = new bool[n];
-        for (int i = 0; i < n; i++) removed[i] = false;
+        maxDegeneracy = 0;
+        for (int i = 0; i < n; i++) {
+            if (d[i] > maxDegeneracy) maxDegeneracy = d[i];
+        }
 
-        int currentDeg = 0;
-        for (int count = 0; count < n; count++) {
-            // Find minimum non-empty bucket
-            while (currentDeg <= maxDeg && bucket[currentDeg].empty()) {
-                currentDeg++;
+        delete[] bin;
+        delete[] pos;
+        delete[] vert;
+    }
+
+    /*
+        buildDegeneracyParallel: level-synchronous k-core decomposition (PKC style).
+        For each level k, nodes with residual degree k form the frontier; their neighbors
+        are decremented atomically and those that drop to k join the next frontier.
+        Decrements never push a residual degree below the current level.
+    */
+    void buildDegeneracyParallel(int numThreads) {
+        if (degeneracy) delete[] degeneracy;
+        degeneracy = new int[n];
+        maxDegeneracy = 0;
+
+        std::atomic<int> *d = new std::atomic<int>[n];
+        for (int i = 0; i < n; i++) d[i].store(degrees[i], std::memory_order_relaxed);
+
+        // degeneracy[v] < 0 marks a node not yet peeled
+        vector<int> remaining(n);   // nodes not yet peeled
+        for (int i = 0; i < n; i++) {
+            remaining[i] = i;
+            degeneracy[i] = -1;
+        }
+
+        vector<int> frontier, next;
+        vector<vector<int>> local(numThreads);  // per-thread next frontier buffers
+
+        int done = 0;
+        for (int level = 0; done < n; level++) {
+            // Collect the level's initial frontier and compact the remaining nodes;
+            // nodes peeled in an earlier cascade are dropped by their flag, since
+            // their residual degree stays at the level they were peeled at
+            frontier.clear();
+            size_t keep = 0;
+            for (int v : remaining) {
+                if (degeneracy[v] >= 0) continue;
+                if (d[v].load(std::memory_order_relaxed) == level) frontier.push_back(v);
+                else remaining[keep++] = v;
             }
+            remaining.resize(keep);
 
-            // Remove a node from the minimum bucket
-            int v = bucket[currentDeg].back();
-            bucket[currentDeg].pop_back();
-            removed[v] = true;
-            degeneracy[v] = currentDeg;
-            if (currentDeg > maxDegeneracy) maxDegeneracy = currentDeg;
-
-            // Update neighbors
-            for (int u : neighborhoods[v]) {
-                if (!removed[u] && d[u] > 0) {
-                    int oldDeg = d[u];
-                    int pos = nodePos[u];
-                    
-                    // Swap with last element in old bucket
-                    if (pos < (int)bucket[oldDeg].size() - 1) {
-                        int last = bucket[oldDeg].back();
-                        bucket[oldDeg][pos] = last;
-                        nodePos[last] = pos;
+            while (!frontier.empty()) {
+                for (vector<int> &buf : local) buf.clear();
+
+                parallelFor(frontier.size(), numThreads, [&](int t, size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                        int v = frontier[i];
+                        degeneracy[v] = level;
+                        for (int u : neighbors(v)) {
+                            if (d[u].load(std::memory_order_relaxed) > level) {
+                                int old = d[u].fetch_sub(1, std::memory_order_relaxed);
+                                if (old == level + 1) {
+                                    local[t].push_back(u);
+                                } else if (old <= level) {
+                                    d[u].fetch_add(1, std::memory_order_relaxed);
+                                }
+                            }
+                        }
                     }
-                    bucket[oldDeg].pop_back();
+                });
 
-                    // Move to new bucket
-                    d[u]--;
-                    nodePos[u] = bucket[d[u]].size();
-                    bucket[d[u]].push_back(u);
+                done += frontier.size();
+                maxDegeneracy = level;
 
-                    // Can decrease currentDeg
-                    if (d[u] < currentDeg) currentDeg = d[u];
-                }
+                next.clear();
+                for (vector<int> &buf : local) next.insert(next.end(), buf.begin(), buf.end());
+                frontier.swap(next);
             }
         }
 
         delete[] d;
-        delete[] bucket;
-        delete[] nodePos;
-        delete[] removed;
     }
-};
\ No newline at end of file
+};
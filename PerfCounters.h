@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+/*
+    PerfCounters: hardware counters (cycles, instructions, last-level cache
+    misses, branch misses) of the calling thread through perf_event_open.
+    Counters run from construction; start()/stop() accumulate the counts of
+    the enclosed region into total.
+    Each event is opened separately, so one missing event does not disable the
+    others; where perf_event_open is unavailable (non-Linux, containers,
+    perf_event_paranoid) every event reports as unavailable and counts stay 0.
+*/
+struct PerfCounters {
+    enum Event { CYCLES = 0, INSTRUCTIONS = 1, CACHE_MISSES = 2, BRANCH_MISSES = 3, NUM_EVENTS = 4 };
+
+    int fd[NUM_EVENTS];             // event file descriptors (-1 if unavailable)
+    uint64_t begin[NUM_EVENTS];     // counter values at the last start()
+    uint64_t total[NUM_EVENTS];     // accumulated counts of all start()/stop() regions
+
+    PerfCounters() {
+        for (int e = 0; e < NUM_EVENTS; e++) {
+            fd[e] = -1;
+            begin[e] = 0;
+            total[e] = 0;
+        }
+#ifdef __linux__
+        static const uint64_t configs[NUM_EVENTS] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES
+        };
+        for (int e = 0; e < NUM_EVENTS; e++) {
+            struct perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[e];
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd[e] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+#endif
+    }
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int e = 0; e < NUM_EVENTS; e++) {
+            if (fd[e] >= 0) close(fd[e]);
+        }
+#endif
+    }
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available(int e) const {
+        return fd[e] >= 0;
+    }
+
+    // True if at least one event could be opened
+    bool anyAvailable() const {
+        for (int e = 0; e < NUM_EVENTS; e++) {
+            if (fd[e] >= 0) return true;
+        }
+        return false;
+    }
+
+    uint64_t readCounter(int e) const {
+        uint64_t value = 0;
+#ifdef __linux__
+        if (fd[e] >= 0 && read(fd[e], &value, sizeof(value)) != sizeof(value)) value = 0;
+#endif
+        return value;
+    }
+
+    void start() {
+        for (int e = 0; e < NUM_EVENTS; e++) {
+            if (fd[e] >= 0) begin[e] = readCounter(e);
+        }
+    }
+
+    void stop() {
+        for (int e = 0; e < NUM_EVENTS; e++) {
+            if (fd[e] >= 0) total[e] += readCounter(e) - begin[e];
+        }
+    }
+
+    void reset() {
+        for (int e = 0; e < NUM_EVENTS; e++) total[e] = 0;
+    }
+
+    uint64_t cycles() const { return total[CYCLES]; }
+    uint64_t instructions() const { return total[INSTRUCTIONS]; }
+    uint64_t cacheMisses() const { return total[CACHE_MISSES]; }
+    uint64_t branchMisses() const { return total[BRANCH_MISSES]; }
+
+    // Short event name for report columns
+    static const char *eventName(int e) {
+        static const char *names[NUM_EVENTS] = {"Cycles", "Instr", "LLC_Miss", "Br_Miss"};
+        return names[e];
+    }
+};
+
+/*
+    PhaseCounters: one PerfCounters per phase of an MMAS iteration
+    (construction, local search, pheromone update), so the phases can be
+    told apart as memory or compute bound.
+*/
+struct PhaseCounters {
+    enum Phase { CONSTRUCTION = 0, LOCAL_SEARCH = 1, PHEROMONE = 2, NUM_PHASES = 3 };
+
+    PerfCounters phases[NUM_PHASES];
+
+    void start(int p) { phases[p].start(); }
+    void stop(int p) { phases[p].stop(); }
+
+    void reset() {
+        for (int p = 0; p < NUM_PHASES; p++) phases[p].reset();
+    }
+
+    bool available(int e) const {
+        return phases[0].available(e);
+    }
+
+    bool anyAvailable() const {
+        return phases[0].anyAvailable();
+    }
+
+    // Count of event e in phase p
+    uint64_t count(int p, int e) const {
+        return phases[p].total[e];
+    }
+
+    // Count of event e over all phases
+    uint64_t total(int e) const {
+        uint64_t sum = 0;
+        for (int p = 0; p < NUM_PHASES; p++) sum += phases[p].total[e];
+        return sum;
+    }
+
+    // Short phase name for report columns
+    static const char *phaseName(int p) {
+        static const char *names[NUM_PHASES] = {"Constr", "LS", "Pher"};
+        return names[p];
+    }
+};
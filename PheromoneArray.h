@@ -9,6 +9,10 @@ struct pheromoneArray {
     float evaporation_rate;     // rate at which pheromones evaporate
     float tau_min;              // minimum pheromone level (MMAS)
     float tau_max;              // maximum pheromone level (MMAS)
+    int active;                 // nodes above tau_min + BRANCHING_LAMBDA * (tau_max - tau_min) after the last evaporate()
+
+    // Share of the pheromone range a node must exceed to count as active (lambda-branching)
+    static constexpr float BRANCHING_LAMBDA = 0.05f;
 
     pheromoneArray(int n, float evaporation_rate, float tau_min = 1.0f, float tau_max = 100.0f) {
         
@@ -16,6 +20,7 @@ struct pheromoneArray {
         this->evaporation_rate = evaporation_rate;
         this->tau_min = tau_min;
         this->tau_max = tau_max;
+        active = n;
 
         pheromones = new float[n];
         for (int i = 0; i < n; i++) {
@@ -29,6 +34,7 @@ struct pheromoneArray {
         evaporation_rate = other.evaporation_rate;
         tau_min = other.tau_min;
         tau_max = other.tau_max;
+        active = other.active;
         pheromones = new float[n];
         memcpy(pheromones, other.pheromones, n * sizeof(float));
     }
@@ -41,6 +47,7 @@ struct pheromoneArray {
             evaporation_rate = other.evaporation_rate;
             tau_min = other.tau_min;
             tau_max = other.tau_max;
+            active = other.active;
             pheromones = new float[n];
             memcpy(pheromones, other.pheromones, n * sizeof(float));
         }
@@ -51,13 +58,42 @@ struct pheromoneArray {
         delete[] pheromones;
     }
 
+    /*
+        Evaporate: scale every pheromone level by (1 - evaporation_rate), clamped to tau_min.
+        The same pass counts the active nodes, a node analogue of the lambda-branching
+        factor: it falls towards the size of the reinforced solutions as the trail converges.
+    */
     void evaporate() {
+        float threshold = tau_min + BRANCHING_LAMBDA * (tau_max - tau_min);
+        int count = 0;
         for (int i = 0; i < n; i++) {
             pheromones[i] = pheromones[i] * (1.0f - evaporation_rate);
             // MMAS: clamp to tau_min
             if (pheromones[i] < tau_min) {
                 pheromones[i] = tau_min; 
             }
+            count += pheromones[i] > threshold;
+        }
+        active = count;
+    }
+
+    /*
+        Reinitialize: reset every pheromone level to tau_max (MMAS restart).
+    */
+    void reinitialize() {
+        for (int i = 0; i < n; i++) {
+            pheromones[i] = tau_max;
+        }
+        active = n;
+    }
+
+    /*
+        Clamp: bring every pheromone level into [tau_min, tau_max] after the bounds change.
+    */
+    void clamp() {
+        for (int i = 0; i < n; i++) {
+            if (pheromones[i] < tau_min) pheromones[i] = tau_min;
+            if (pheromones[i] > tau_max) pheromones[i] = tau_max;
         }
     }
 
@@ -82,9 +118,11 @@ struct pheromoneArray {
         pheromones[node] = 0.0f;
     }
     /*
-        InvalidateVector: set the pheromone level of a group of nodes in a vector to 0 and propagate the changes up the tree.
+        InvalidateVector: set the pheromone level of a group of nodes to 0 and propagate the changes up the tree.
+        nodes may be a std::vector<int> or a NeighRange (plain or compressed adjacency).
     */
-    void invalidateVector(const std::vector<int>& nodes) {
+    template <typename Range>
+    void invalidateVector(const Range& nodes) {
         for (int node : nodes) {
             pheromones[node] = 0.0f;
         }
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include "MMAS.h"
+
+/*
+    RunConfig: solver parameters of one MMAS run, as set by the command line
+    options of benchmark.cpp. Shared by the single-instance, directory and
+    tuning server modes so every mode accepts the same options.
+*/
+struct RunConfig {
+    double time_limit = 10.0;       // default time limit seconds
+    int max_iterations = 0;         // deterministic iteration budget (0=off)
+    long long max_work = 0;         // deterministic work-unit budget (0=off)
+    int m = 20;                     // number of ants per iteration
+    float alpha = 2.0f;             // pheromone influence exponent
+    float beta = 3.0f;              // degree heuristic influence exponent
+    float gamma = 0.0f;             // degeneracy heuristic influence exponent
+    float delta = 0.1f;             // conflict heuristic influence exponent
+    float rho = 0.9272f;            // evaporation rate
+    float tau_min = 7.0768f;        // MMAS: minimum pheromone level
+    float tau_max = 522.4943f;      // MMAS: maximum pheromone level
+    int ls_budget = 5;              // local search budget (0=off, 1=1-1 swaps, >1=also 2-1)
+    unsigned int seed = 1;          // random generator seed
+    long long cacheSize = 0;        // solution cache entries (0=off)
+    int exactThreshold = 0;         // exact completion below this many candidates (0=off)
+    long long exactNodes = 100000;  // branch and bound node limit per exact completion
+    double ilsFraction = 0.0;       // share of work spent in ILS on the global best (0=off)
+    int ilsStrength = 2;            // nodes force-inserted per ILS perturbation
+    int candidateK = 0;             // candidate-list pool size (0=full candidate set)
+    int batchSize = 0;              // ants constructed in lockstep (0=off, at most 64)
+    double pBest = 0.0;             // adaptive pheromone bounds from the best size (0=fixed -min/-max)
+    double restartBranching = 0.0;  // restart when active nodes < factor * best size (0=off)
+    int restartWait = 25;           // iterations without restart-best improvement before a restart
+    bool depositSchedule = false;   // interleave restart/global-best deposits
+
+    /*
+        parseOption: applies the solver option at argv[i] (advancing i past its value).
+        Returns false if argv[i] is not a solver option.
+    */
+    bool parseOption(int argc, char **argv, int &i) {
+        const char *opt = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (strcmp(opt, "-schedule") == 0) {
+            depositSchedule = true;
+            return true;
+        }
+        if (!hasValue) return false;
+
+        const char *value = argv[i + 1];
+        if (strcmp(opt, "-t") == 0) {
+            time_limit = atof(value);
+        } else if (strcmp(opt, "-it") == 0) {
+            max_iterations = atoi(value);
+        } else if (strcmp(opt, "-w") == 0) {
+            max_work = strtoll(value, nullptr, 10);
+        } else if (strcmp(opt, "-m") == 0) {
+            m = atoi(value);
+        } else if (strcmp(opt, "-a") == 0) {
+            alpha = atof(value);
+        } else if (strcmp(opt, "-b") == 0) {
+            beta = atof(value);
+        } else if (strcmp(opt, "-g") == 0) {
+            gamma = atof(value);
+        } else if (strcmp(opt, "-d") == 0) {
+            delta = atof(value);
+        } else if (strcmp(opt, "-r") == 0) {
+            rho = atof(value);
+        } else if (strcmp(opt, "-min") == 0) {
+            tau_min = atof(value);
+        } else if (strcmp(opt, "-max") == 0) {
+            tau_max = atof(value);
+        } else if (strcmp(opt, "-ls") == 0) {
+            ls_budget = atoi(value);
+        } else if (strcmp(opt, "-s") == 0) {
+            seed = strtoul(value, nullptr, 10);
+        } else if (strcmp(opt, "-cache") == 0) {
+            cacheSize = strtoll(value, nullptr, 10);
+        } else if (strcmp(opt, "-exact") == 0) {
+            exactThreshold = atoi(value);
+        } else if (strcmp(opt, "-exact-nodes") == 0) {
+            exactNodes = strtoll(value, nullptr, 10);
+        } else if (strcmp(opt, "-ils") == 0) {
+            ilsFraction = atof(value);
+        } else if (strcmp(opt, "-ils-k") == 0) {
+            ilsStrength = atoi(value);
+        } else if (strcmp(opt, "-cl") == 0) {
+            candidateK = atoi(value);
+        } else if (strcmp(opt, "-batch") == 0) {
+            batchSize = atoi(value);
+        } else if (strcmp(opt, "-pbest") == 0) {
+            pBest = atof(value);
+        } else if (strcmp(opt, "-restart") == 0) {
+            restartBranching = atof(value);
+        } else if (strcmp(opt, "-restart-wait") == 0) {
+            restartWait = atoi(value);
+        } else {
+            return false;
+        }
+        i++;
+        return true;
+    }
+
+    // validate: returns an error message for invalid parameters, nullptr if valid
+    const char *validate() const {
+        if (max_iterations < 0 || max_work < 0) return "Iteration and work budgets must be non-negative";
+        if (time_limit <= 0 && max_iterations == 0 && max_work == 0) return "Time limit must be positive";
+        if (m <= 0) return "Number of ants must be positive";
+        if (alpha < 0 || beta < 0 || gamma < 0 || delta < 0) return "alpha, beta, gamma and delta must be non-negative";
+        if (rho <= 0 || rho > 1) return "rho must be in (0, 1]";
+        if (tau_min >= tau_max) return "tau_min must be less than tau_max";
+        if (tau_min <= 0) return "tau_min must be positive";
+        if (exactThreshold < 0 || exactNodes < 0) return "Exact completion threshold and node limit must be non-negative";
+        if (exactThreshold > ExactMIS::MAX_NODES) return "Exact completion threshold must be at most 1024";
+        if (ilsFraction < 0 || ilsFraction >= 1) return "ILS fraction must be in [0, 1)";
+        if (ilsStrength <= 0) return "ILS strength must be positive";
+        if (candidateK < 0) return "Candidate list size must be non-negative";
+        if (candidateK > 0 && exactThreshold > 0) return "Candidate lists do not support exact completion (-cl with -exact)";
+        if (batchSize != 0 && (batchSize < 2 || batchSize > 64)) return "Batch size must be between 2 and 64";
+        if (batchSize > 0 && (candidateK > 0 || exactThreshold > 0)) return "Batch construction does not support candidate lists or exact completion (-batch with -cl or -exact)";
+        if (pBest < 0 || pBest >= 1) return "p_best must be in [0, 1)";
+        if (restartBranching < 0 || restartWait < 0) return "Restart factor and wait must be non-negative";
+        if (cacheSize < 0) return "Cache size must be non-negative";
+        return nullptr;
+    }
+
+    // createSolver: a solver on nl with every enabled option applied
+    MMASSolver *createSolver(NeighList *nl, bool verbose) const {
+        MMASSolver *solver = new MMASSolver(nl, m, alpha, beta, gamma, delta, rho, tau_min, tau_max, ls_budget, verbose, seed);
+        if (cacheSize > 0) solver->enableSolutionCache(cacheSize);
+        if (exactThreshold > 0) solver->enableExactCompletion(exactThreshold, exactNodes);
+        if (ilsFraction > 0) solver->enableIntensification(ilsFraction, ilsStrength);
+        if (candidateK > 0) solver->enableCandidateList(candidateK);
+        if (batchSize > 0) solver->enableBatchConstruction(batchSize);
+        if (pBest > 0) solver->enableAdaptiveBounds(pBest);
+        if (restartBranching > 0) solver->enableRestarts(restartBranching, restartWait);
+        if (depositSchedule) solver->enableDepositSchedule();
+        return solver;
+    }
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+/*
+    SolutionCache: bounded map from the Zobrist hash of a constructed solution
+    to its local search result, so duplicate constructions skip local search.
+    The table is split into shards with one mutex each so concurrent ants rarely
+    contend. Each shard evicts its oldest entry (FIFO) once full.
+*/
+struct SolutionCache {
+    static const int NUM_SHARDS = 16;
+
+    struct Shard {
+        std::mutex mtx;
+        std::unordered_map<uint64_t, std::vector<int>> entries;
+        std::deque<uint64_t> order;     // insertion order for eviction
+    };
+
+    Shard shards[NUM_SHARDS];
+    size_t shardCapacity;               // maximum entries per shard
+    std::atomic<long long> lookups;     // lookup() calls
+    std::atomic<long long> hits;        // successful lookups
+
+    SolutionCache(size_t capacity) : lookups(0), hits(0) {
+        shardCapacity = (capacity + NUM_SHARDS - 1) / NUM_SHARDS;
+        if (shardCapacity == 0) shardCapacity = 1;
+    }
+
+    Shard &shardOf(uint64_t key) {
+        return shards[(key >> 59) % NUM_SHARDS];
+    }
+
+    // lookup: copies the cached result for key into out. Returns false on a miss.
+    bool lookup(uint64_t key, std::vector<int> &out) {
+        lookups++;
+        Shard &shard = shardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        auto found = shard.entries.find(key);
+        if (found == shard.entries.end()) {
+            return false;
+        }
+        out = found->second;
+        hits++;
+        return true;
+    }
+
+    // insert: stores the local search result for key, evicting the oldest entry if the shard is full
+    void insert(uint64_t key, const std::vector<int> &result) {
+        Shard &shard = shardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        if (shard.entries.count(key)) {
+            return;
+        }
+        if (shard.entries.size() >= shardCapacity) {
+            shard.entries.erase(shard.order.front());
+            shard.order.pop_front();
+        }
+        shard.entries.emplace(key, result);
+        shard.order.push_back(key);
+    }
+
+    // Drop all entries (results are stale once the graph changes)
+    void clear() {
+        for (Shard &shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mtx);
+            shard.entries.clear();
+            shard.order.clear();
+        }
+    }
+
+    double hitRate() const {
+        long long l = lookups;
+        return l > 0 ? (double)hits / l : 0.0;
+    }
+};
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "MMAS.h"
+#include "RunConfig.h"
+#include "loader.h"
+
+/*
+    TuningServer: evaluates parameter configurations for a tuner (e.g. irace)
+    inside one long-lived process.
+    Reads one job per stdin line:    <id> <instance> [options]
+    and streams one line per result: <id> <-best> <seconds>
+    (negated like the single-instance output, for minimization), or
+    <id> ERROR <message>. Results are written as jobs finish, not in input order.
+    Options are the solver options of benchmark.cpp, applied on top of the
+    process's command line configuration.
+    Each instance is loaded once and kept; its degeneracy and Zobrist keys are
+    built up front so the shared NeighList is only read by the worker threads.
+*/
+struct TuningServer {
+    // A loaded instance, built at most once
+    struct Instance {
+        std::once_flag loaded;
+        NeighList *nl = nullptr;
+    };
+
+    // A parsed job line
+    struct Job {
+        std::string id;
+        std::string instance;
+        RunConfig config;
+    };
+
+    RunConfig base;                     // configuration from the command line
+    bool compress;                      // store adjacency as delta-encoded varints
+    int degThreads;                     // threads for degeneracy computation
+    int numThreads;                     // concurrent evaluations
+
+    std::unordered_map<std::string, Instance*> instances;
+    std::mutex instancesMtx;
+
+    std::deque<Job> queue;              // parsed jobs waiting for a worker
+    bool closed;                        // input exhausted
+    std::mutex queueMtx;
+    std::condition_variable queueCv;
+
+    FILE *out;                          // result stream
+    std::mutex outMtx;
+
+    TuningServer(const RunConfig &base, bool compress, int degThreads, int numThreads)
+     : base(base), compress(compress), degThreads(degThreads), numThreads(numThreads), closed(false), out(stdout) {}
+
+    ~TuningServer() {
+        for (auto &entry : instances) {
+            delete entry.second->nl;
+            delete entry.second;
+        }
+    }
+
+    // Load an instance on first use; nullptr if it cannot be read
+    NeighList *getInstance(const std::string &path) {
+        Instance *instance;
+        {
+            std::lock_guard<std::mutex> lock(instancesMtx);
+            Instance *&slot = instances[path];
+            if (slot == nullptr) slot = new Instance();
+            instance = slot;
+        }
+        std::call_once(instance->loaded, [&] {
+            NeighList *nl = loadGraph(path.c_str());
+            if (nl == nullptr) return;
+            if (compress) nl->compress();
+            nl->buildDegeneracy(degThreads);
+            nl->buildZobrist();
+            instance->nl = nl;
+        });
+        return instance->nl;
+    }
+
+    // Write "<id> <text>" as one line
+    void respond(const std::string &id, const char *text) {
+        std::lock_guard<std::mutex> lock(outMtx);
+        fprintf(out, "%s %s\n", id.c_str(), text);
+        fflush(out);
+    }
+
+    void respondError(const std::string &id, const char *message) {
+        std::string text = std::string("ERROR ") + message;
+        respond(id.empty() ? "?" : id, text.c_str());
+    }
+
+    // Parse "<id> <instance> [options]"; returns an error message or nullptr
+    const char *parseJob(char *line, Job &job) {
+        std::vector<char*> tokens;
+        for (char *tok = strtok(line, " \t\r\n"); tok != nullptr; tok = strtok(nullptr, " \t\r\n")) {
+            tokens.push_back(tok);
+        }
+        if (!tokens.empty()) job.id = tokens[0];
+        if (tokens.size() < 2) return "expected <id> <instance> [options]";
+
+        job.instance = tokens[1];
+        job.config = base;
+        int argc = tokens.size();
+        for (int i = 2; i < argc; i++) {
+            if (!job.config.parseOption(argc, tokens.data(), i)) return "unknown option";
+        }
+        return job.config.validate();
+    }
+
+    void evaluate(const Job &job) {
+        NeighList *nl = getInstance(job.instance);
+        if (nl == nullptr) {
+            respondError(job.id, "could not load instance");
+            return;
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        MMASSolver *solver = job.config.createSolver(nl, false);
+        int best = solver->solve(job.config.time_limit, job.config.max_iterations, job.config.max_work);
+        delete solver;
+        double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+        char result[64];
+        snprintf(result, sizeof(result), "%d %.4f", -best, seconds);
+        respond(job.id, result);
+    }
+
+    void worker() {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(queueMtx);
+                queueCv.wait(lock, [this] { return !queue.empty() || closed; });
+                if (queue.empty()) return;
+                job = std::move(queue.front());
+                queue.pop_front();
+            }
+            evaluate(job);
+        }
+    }
+
+    // run: serve jobs from in until end of input and all results are written
+    int run(std::istream &in) {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < numThreads; t++) {
+            workers.emplace_back(&TuningServer::worker, this);
+        }
+
+        // Lines of any length: option lists are not truncated into a different job
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) continue;     // blank line
+
+            Job job;
+            const char *error = parseJob(&line[0], job);
+            if (error != nullptr) {
+                respondError(job.id, error);
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> lock(queueMtx);
+                queue.push_back(std::move(job));
+            }
+            queueCv.notify_one();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queueMtx);
+            closed = true;
+        }
+        queueCv.notify_all();
+        for (std::thread &w : workers) w.join();
+        return 0;
+    }
+};
@@ -6,105 +6,149 @@
 #include <sys/stat.h>
 #include "MMAS.h"
 #include "loader.h"
+#include "PerfCounters.h"
+#include "RunConfig.h"
+#include "TuningServer.h"
+
+// CSV header of the hardware counter columns: per iteration for each phase, then per vertex
+void printPerfHeader() {
+    for (int p = 0; p < PhaseCounters::NUM_PHASES; p++) {
+        for (int e = 0; e < PerfCounters::NUM_EVENTS; e++) {
+            printf(",%s_%s_per_it", PhaseCounters::phaseName(p), PerfCounters::eventName(e));
+        }
+    }
+    for (int e = 0; e < PerfCounters::NUM_EVENTS; e++) {
+        printf(",%s_per_vertex", PerfCounters::eventName(e));
+    }
+}
 
 
 int main(int argc, char *argv[]) {
     // Default MMAS parameters
     char *path = nullptr;
-    double time_limit = 10.0;       // default time limit seconds
-    int m = 20;                     // number of ants per iteration
-    float alpha = 2.0f;             // pheromone influence exponent
-    float beta = 3.0f;              // degree heuristic influence exponent
-    float gamma = 0.0f;             // degeneracy heuristic influence exponent
-    float delta = 0.1f;             // conflict heuristic influence exponent
-    float rho = 0.9272f;              // evaporation rate
-    float tau_min = 7.0768f;           // MMAS: minimum pheromone level
-    float tau_max = 522.4943f;         // MMAS: maximum pheromone level
-    int ls_budget = 5;              // local search budget (0=off, 1=1-1 swaps, >1=also 2-1)
+    RunConfig config;               // solver parameters (see RunConfig for the defaults)
+    char *ckptPath = nullptr;       // checkpoint output file (single instance only)
+    double ckptEvery = 60.0;        // seconds between periodic checkpoints (0 = on signal only)
+    char *resumePath = nullptr;     // checkpoint to resume from (single instance only)
     bool verbose = false;           // verbose flag
+    bool compress = false;          // store adjacency as delta-encoded varints
+    int degThreads = 1;             // threads for degeneracy computation (1=sequential)
+    bool perfCounters = false;      // hardware counters per iteration phase
+    bool serve = false;             // tuning server: evaluate configurations read from stdin
+    int serveThreads = std::thread::hardware_concurrency();   // concurrent evaluations when serving
 
     // Parse required arguments
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
             path = argv[++i];
+        } else if (strcmp(argv[i], "-serve") == 0) {
+            serve = true;
         }
     }
 
     // Validate parameters
-    if (path == nullptr) {
-        fprintf(stderr, "Usage: %s -i <path> [-t <time>] [-m <ants>] [-a <alpha>] [-b <beta>] [-g <gamma>] [-d <delta>] [-r <rho>] [-min <tau_min>] [-max <tau_max>] [-ls <budget>] [-v]\n", argv[0]);
+    if (path == nullptr && !serve) {
+        fprintf(stderr, "Usage: %s -i <path> [-t <time>] [-it <iters>] [-w <work>] [-m <ants>] [-a <alpha>] [-b <beta>] [-g <gamma>] [-d <delta>] [-r <rho>] [-min <tau_min>] [-max <tau_max>] [-ls <budget>] [-s <seed>] [-cache <entries>] [-exact <k>] [-exact-nodes <n>] [-ils <fraction>] [-ils-k <k>] [-cl <k>] [-batch <B>] [-pbest <p>] [-restart <factor>] [-restart-wait <iters>] [-schedule] [-c] [-dt <threads>] [-ckpt <file>] [-ckpt-every <sec>] [-resume <file>] [-perf] [-v]\n", argv[0]);
+        fprintf(stderr, "       %s -serve [-threads <n>] [options]\n", argv[0]);
         fprintf(stderr, "\nMandatory:\n");
-        fprintf(stderr, "  -i <path>      : Path to graph instance file/directory (required)\n");
+        fprintf(stderr, "  -i <path>      : Path to graph instance file/directory (required unless -serve)\n");
         fprintf(stderr, "\nMMAS Parameters:\n");
-        fprintf(stderr, "  -t <time>      : Time limit in seconds (default: %.2f)\n", time_limit);
-        fprintf(stderr, "  -m <ants>      : Number of ants per iteration (default: %d)\n", m);
-        fprintf(stderr, "  -a <alpha>     : Pheromone influence exponent (default: %.2f)\n", alpha);
-        fprintf(stderr, "  -b <beta>      : Degree heuristic influence exponent (default: %.2f)\n", beta);
-        fprintf(stderr, "  -g <gamma>     : Degeneracy heuristic influence exponent (default: %.2f)\n", gamma);
-        fprintf(stderr, "  -d <delta>     : Conflict heuristic influence exponent (default: %.2f)\n", delta);
-        fprintf(stderr, "  -r <rho>       : Evaporation rate (default: %.2f)\n", rho);
-        fprintf(stderr, "  -min <tau_min> : Minimum pheromone level (default: %.2f)\n", tau_min);
-        fprintf(stderr, "  -max <tau_max> : Maximum pheromone level (default: %.2f)\n", tau_max);
-        fprintf(stderr, "  -ls <budget>   : Local search budget (0=off, 1=1-1 swaps, >1=also 2-1) (default: %d)\n", ls_budget);
+        fprintf(stderr, "  -t <time>      : Time limit in seconds; wall-clock guard when -it/-w is set, 0 = none (default: %.2f)\n", config.time_limit);
+        fprintf(stderr, "  -it <iters>    : Deterministic budget: maximum iterations (default: off)\n");
+        fprintf(stderr, "  -w <work>      : Deterministic budget: maximum work units (default: off)\n");
+        fprintf(stderr, "  -m <ants>      : Number of ants per iteration (default: %d)\n", config.m);
+        fprintf(stderr, "  -a <alpha>     : Pheromone influence exponent (default: %.2f)\n", config.alpha);
+        fprintf(stderr, "  -b <beta>      : Degree heuristic influence exponent (default: %.2f)\n", config.beta);
+        fprintf(stderr, "  -g <gamma>     : Degeneracy heuristic influence exponent (default: %.2f)\n", config.gamma);
+        fprintf(stderr, "  -d <delta>     : Conflict heuristic influence exponent (default: %.2f)\n", config.delta);
+        fprintf(stderr, "  -r <rho>       : Evaporation rate (default: %.2f)\n", config.rho);
+        fprintf(stderr, "  -min <tau_min> : Minimum pheromone level (default: %.2f)\n", config.tau_min);
+        fprintf(stderr, "  -max <tau_max> : Maximum pheromone level (default: %.2f)\n", config.tau_max);
+        fprintf(stderr, "  -ls <budget>   : Local search budget (0=off, 1=1-1 swaps, >1=also 2-1) (default: %d)\n", config.ls_budget);
+        fprintf(stderr, "  -s <seed>      : Random generator seed (default: %u)\n", config.seed);
+        fprintf(stderr, "  -cache <entries> : Skip local search for repeated constructions, cache size (default: off)\n");
+        fprintf(stderr, "  -exact <k>     : Finish construction exactly once <= k candidates remain, k <= %d (default: off)\n", ExactMIS::MAX_NODES);
+        fprintf(stderr, "  -exact-nodes <n> : Branch and bound node limit per exact completion, 0 = none (default: %lld)\n", config.exactNodes);
+        fprintf(stderr, "  -ils <fraction> : Share of work spent in iterated local search on the global best (default: off)\n");
+        fprintf(stderr, "  -ils-k <k>     : Nodes force-inserted per ILS perturbation (default: %d)\n", config.ilsStrength);
+        fprintf(stderr, "  -cl <k>        : Sample each step from the top-k ranked valid nodes (default: off)\n");
+        fprintf(stderr, "  -batch <B>     : Construct B ants in lockstep, 2 to 64 (default: off)\n");
+        fprintf(stderr, "  -pbest <p>     : Adaptive bounds tau_max = best/rho, tau_min from p_best, e.g. 0.05 (default: off)\n");
+        fprintf(stderr, "  -restart <factor> : Reset pheromones to tau_max when fewer than factor * best size\n");
+        fprintf(stderr, "                   nodes stay above tau_min, e.g. 1.5 (default: off)\n");
+        fprintf(stderr, "  -restart-wait <iters> : Iterations without restart-best improvement before a restart (default: %d)\n", config.restartWait);
+        fprintf(stderr, "  -schedule      : Interleave restart-best/global-best deposits with iteration-best ones\n");
+        fprintf(stderr, "\nGraph Storage:\n");
+        fprintf(stderr, "  -c             : Compressed adjacency (sorted, delta-encoded varints)\n");
+        fprintf(stderr, "  -dt <threads>  : Threads for degeneracy computation (default: %d)\n", degThreads);
+        fprintf(stderr, "\nCheckpointing (single instance only):\n");
+        fprintf(stderr, "  -ckpt <file>   : Write checkpoints to file (also on SIGUSR1; SIGTERM/SIGINT checkpoint and stop)\n");
+        fprintf(stderr, "  -ckpt-every <sec> : Seconds between periodic checkpoints, 0 = on signal only (default: %.0f)\n", ckptEvery);
+        fprintf(stderr, "  -resume <file> : Resume the run stored in a checkpoint (time limit includes its elapsed time)\n");
+        fprintf(stderr, "\nTuning Server:\n");
+        fprintf(stderr, "  -serve         : Read '<id> <instance> [options]' lines from stdin, write '<id> <-best> <seconds>'\n");
+        fprintf(stderr, "                   as runs finish; instances are loaded once, line options override the command line\n");
+        fprintf(stderr, "  -threads <n>   : Concurrent evaluations in server mode (default: %d)\n", serveThreads);
+        fprintf(stderr, "\nOutput:\n");
         fprintf(stderr, "  -v             : Verbose output\n");
+        fprintf(stderr, "  -perf          : Hardware counters (cycles, instructions, LLC and branch misses) per phase,\n");
+        fprintf(stderr, "                   per iteration and per vertex; NA where perf_event_open is unavailable\n");
         return 1;
     }
 
     // Parse optional arguments
     for (int i = 1; i < argc; i++) {
-        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
-            time_limit = atof(argv[++i]);
-        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
-            m = atoi(argv[++i]);
-        } else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) {
-            alpha = atof(argv[++i]);
-        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
-            beta = atof(argv[++i]);
-        } else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
-            gamma = atof(argv[++i]);
-        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
-            delta = atof(argv[++i]);
-        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
-            rho = atof(argv[++i]);
-        } else if (strcmp(argv[i], "-min") == 0 && i + 1 < argc) {
-            tau_min = atof(argv[++i]);
-        } else if (strcmp(argv[i], "-max") == 0 && i + 1 < argc) {
-            tau_max = atof(argv[++i]);
-        } else if (strcmp(argv[i], "-ls") == 0 && i + 1 < argc) {
-            ls_budget = atoi(argv[++i]);
+        if (config.parseOption(argc, argv, i)) {
+            continue;
+        } else if (strcmp(argv[i], "-dt") == 0 && i + 1 < argc) {
+            degThreads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-ckpt") == 0 && i + 1 < argc) {
+            ckptPath = argv[++i];
+        } else if (strcmp(argv[i], "-ckpt-every") == 0 && i + 1 < argc) {
+            ckptEvery = atof(argv[++i]);
+        } else if (strcmp(argv[i], "-resume") == 0 && i + 1 < argc) {
+            resumePath = argv[++i];
+        } else if (strcmp(argv[i], "-c") == 0) {
+            compress = true;
         } else if (strcmp(argv[i], "-v") == 0) {
             verbose = true;
+        } else if (strcmp(argv[i], "-perf") == 0) {
+            perfCounters = true;
+        } else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc) {
+            serveThreads = atoi(argv[++i]);
         }
     }
 
-    if (time_limit <= 0) {
-        fprintf(stderr, "Error: Time limit must be positive\n");
+    const char *error = config.validate();
+    if (error != nullptr) {
+        fprintf(stderr, "Error: %s\n", error);
         return 1;
     }
 
-    if (m <= 0) {
-        fprintf(stderr, "Error: Number of ants must be positive\n");
+    if (degThreads <= 0) {
+        fprintf(stderr, "Error: Number of degeneracy threads must be positive\n");
         return 1;
     }
 
-    if (alpha < 0 || beta < 0 || gamma < 0 || delta < 0) {
-        fprintf(stderr, "Error: alpha, beta, gamma and delta must be non-negative\n");
+    if (ckptEvery < 0) {
+        fprintf(stderr, "Error: Checkpoint interval must be non-negative\n");
         return 1;
     }
 
-    if (rho <= 0 || rho > 1) {
-        fprintf(stderr, "Error: rho must be in (0, 1]\n");
-        return 1;
+    if (serve) {
+        if (serveThreads <= 0) serveThreads = 1;
+        TuningServer server(config, compress, degThreads, serveThreads);
+        return server.run(std::cin);
     }
 
-    if (tau_min >= tau_max) {
-        fprintf(stderr, "Error: tau_min must be less than tau_max\n");
-        return 1;
-    }
-
-    if (tau_min <= 0) {
-        fprintf(stderr, "Error: tau_min must be positive\n");
-        return 1;
+    // Probe once which hardware events can be counted
+    bool perfAvailable[PerfCounters::NUM_EVENTS] = {};
+    if (perfCounters) {
+        PerfCounters probe;
+        for (int e = 0; e < PerfCounters::NUM_EVENTS; e++) perfAvailable[e] = probe.available(e);
+        if (!probe.anyAvailable()) {
+            fprintf(stderr, "Warning: Hardware counters unavailable (perf_event_open), reporting NA\n");
+        }
     }
 
     struct stat path_stat;
@@ -124,6 +168,10 @@ int main(int argc, char *argv[]) {
             fprintf(stderr, "Error: No files found in directory: %s\n", path);
             return 1;
         }
+        if (ckptPath != nullptr || resumePath != nullptr) {
+            fprintf(stderr, "Error: Checkpointing is only supported for a single instance\n");
+            return 1;
+        }
     } else {
         // single file case
         // Run single file with verbose parameter
@@ -134,12 +182,70 @@ int main(int argc, char *argv[]) {
             return 1;
         }
 
-        int result = MMAS(nl, time_limit, m, alpha, beta, gamma, delta, rho, tau_min, tau_max, ls_budget, verbose);
+        if (compress) {
+            size_t plainBytes = nl->memoryBytes();
+            nl->compress();
+            if (verbose) printf("Adjacency compressed: %zu -> %zu bytes\n", plainBytes, nl->memoryBytes());
+        }
+        if (config.gamma != 0.0f) nl->buildDegeneracy(degThreads);
+
+        MMASSolver *solver = config.createSolver(nl, verbose);
+        solver->setDegeneracyThreads(degThreads);
+
+        if (resumePath != nullptr) {
+            Checkpoint ckpt;
+            if (!ckpt.load(resumePath) || !solver->restore(ckpt)) {
+                fprintf(stderr, "Error: Could not resume from checkpoint: %s\n", resumePath);
+                return 1;
+            }
+            if (verbose) printf("Resumed at iteration %d (%.2fs elapsed, best size %d)\n", solver->iterations, solver->elapsed, solver->global_best_size);
+        }
+
+        if (perfCounters) {
+            solver->enablePerfCounters();
+        }
+
+        if (ckptPath != nullptr) {
+            solver->enableCheckpoints(ckptPath, ckptEvery);
+            // Clear stale requests once; solve() only reads the flags, so a signal
+            // arriving from here on is never lost
+            stopSignal = 0;
+            checkpointSignal = 0;
+            installCheckpointSignals();
+        }
+
+        // Budgets cover the whole run, including the part restored from a checkpoint
+        double timeLeft = config.time_limit > 0 ? config.time_limit - solver->elapsed : 0.0;
+        int iterationsLeft = config.max_iterations > 0 ? config.max_iterations - solver->iterations : 0;
+        long long workLeft = config.max_work > 0 ? config.max_work - solver->work : 0;
+        bool exhausted = (config.max_iterations > 0 && iterationsLeft <= 0) || (config.max_work > 0 && workLeft <= 0)
+            || (config.time_limit > 0 && timeLeft <= 0);
+
+        int result = exhausted ? solver->global_best_size : solver->solve(timeLeft, iterationsLeft, workLeft);
+
+        if (verbose && solver->interrupted) {
+            printf("Interrupted: checkpoint written to %s\n", ckptPath);
+        }
 
         if (!verbose) {
             printf("%d\n", - result); // print negative for irace minimization
         }
 
+        if (verbose && solver->perf && solver->iterations > 0) {
+            int its = solver->iterations;
+            printf("Hardware counters per iteration (per vertex):\n");
+            for (int p = 0; p < PhaseCounters::NUM_PHASES; p++) {
+                printf("  %-7s", PhaseCounters::phaseName(p));
+                for (int e = 0; e < PerfCounters::NUM_EVENTS; e++) {
+                    if (!solver->perf->available(e)) continue;
+                    double perIt = (double)solver->perf->count(p, e) / its;
+                    printf(" %s=%.0f (%.2f)", PerfCounters::eventName(e), perIt, perIt / nl->n);
+                }
+                printf("\n");
+            }
+        }
+
+        delete solver;  // flushes pending checkpoints
         delete nl;
 
         return 0;
@@ -147,7 +253,10 @@ int main(int argc, char *argv[]) {
 
 
     // print csv header
-    printf("Density,Tests,Avg_MISP_Size,Avg_Time(s),Avg_Iterations\n");
+    printf("Density,Tests,Avg_MISP_Size,Avg_Time(s),Avg_Iterations");
+    if (perfCounters) printPerfHeader();
+    if (config.cacheSize > 0) printf(",Avg_Cache_Hit_Rate");
+    printf("\n");
 
 
     // variables
@@ -156,6 +265,9 @@ int main(int argc, char *argv[]) {
     double avgResult = 0.0;
     double avgTime = 0.0;
     double avgIterations = 0.0;
+    double avgHitRate = 0.0;
+    double avgPerfIt[PhaseCounters::NUM_PHASES][PerfCounters::NUM_EVENTS] = {};
+    double avgPerfVertex[PerfCounters::NUM_EVENTS] = {};
 
 
     for (int i = 0; i < fileCount; i++) {
@@ -174,6 +286,9 @@ int main(int argc, char *argv[]) {
                 avgResult = 0.0;
                 avgTime = 0.0;
                 avgIterations = 0.0;
+                avgHitRate = 0.0;
+                memset(avgPerfIt, 0, sizeof(avgPerfIt));
+                memset(avgPerfVertex, 0, sizeof(avgPerfVertex));
                 tests = 0;
                 printf("\n");
             }
@@ -185,13 +300,28 @@ int main(int argc, char *argv[]) {
             fprintf(stderr, "Error: Could not load graph from file: %s\n", fullPath);
             return 1;
         }
-
-        int iterations;
+        if (compress) nl->compress();
+        if (config.gamma != 0.0f) nl->buildDegeneracy(degThreads);
 
         // Run MMAS and measure time
         auto start = std::chrono::high_resolution_clock::now();
-        int misp_size = MMAS(nl, time_limit, m, alpha, beta, gamma, delta, rho, tau_min, tau_max, ls_budget, false, &iterations);
+        MMASSolver *solver = config.createSolver(nl, false);
+        if (perfCounters) solver->enablePerfCounters();
+        int misp_size = solver->solve(config.time_limit, config.max_iterations, config.max_work);
         auto end = std::chrono::high_resolution_clock::now();
+        int iterations = solver->iterations;
+        double hitRate = solver->cache ? solver->cache->hitRate() : 0.0;
+        if (solver->perf && iterations > 0) {
+            for (int e = 0; e < PerfCounters::NUM_EVENTS; e++) {
+                for (int p = 0; p < PhaseCounters::NUM_PHASES; p++) {
+                    double perIt = (double)solver->perf->count(p, e) / iterations;
+                    avgPerfIt[p][e] = (avgPerfIt[p][e] * tests + perIt) / (tests + 1);
+                }
+                double perVertex = (double)solver->perf->total(e) / ((double)iterations * nl->n);
+                avgPerfVertex[e] = (avgPerfVertex[e] * tests + perVertex) / (tests + 1);
+            }
+        }
+        delete solver;
         std::chrono::duration<double> elapsed = end - start;
         double execution_time = elapsed.count();
 
@@ -199,10 +329,25 @@ int main(int argc, char *argv[]) {
         avgResult = (avgResult * tests + misp_size) / (tests + 1);
         avgTime = (avgTime * tests + execution_time) / (tests + 1);
         avgIterations = (avgIterations * tests + iterations) / (tests + 1);
+        avgHitRate = (avgHitRate * tests + hitRate) / (tests + 1);
         tests++;
 
         // print current average results
-        printf("\r0.%d,%d,%.2f,%.4f,%.0f   ", currentDensityDecimal, tests, avgResult, avgTime, avgIterations);
+        printf("\r0.%d,%d,%.2f,%.4f,%.0f", currentDensityDecimal, tests, avgResult, avgTime, avgIterations);
+        if (perfCounters) {
+            for (int p = 0; p < PhaseCounters::NUM_PHASES; p++) {
+                for (int e = 0; e < PerfCounters::NUM_EVENTS; e++) {
+                    if (perfAvailable[e]) printf(",%.0f", avgPerfIt[p][e]);
+                    else printf(",NA");
+                }
+            }
+            for (int e = 0; e < PerfCounters::NUM_EVENTS; e++) {
+                if (perfAvailable[e]) printf(",%.3f", avgPerfVertex[e]);
+                else printf(",NA");
+            }
+        }
+        if (config.cacheSize > 0) printf(",%.4f", avgHitRate);
+        printf("   ");
         fflush(stdout);
 
         // Cleanup
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "NeighList.h"
+
+// Seeded random graph generators. Every generator is deterministic for a given seed.
+
+// Add the undirected edge (u, v) to nl
+void addUndirected(NeighList *nl, int u, int v) {
+    nl->push(u, v);
+    nl->push(v, u);
+}
+
+/*
+    Erdos-Renyi G(n, p) in O(n + m) by geometric skipping (Batagelj-Brandes).
+    skip [in]: optional node mask; pairs with both ends marked are not connected
+*/
+NeighList *generateGnp(int n, double p, uint64_t seed, const std::vector<char> *skip = nullptr) {
+    NeighList *nl = new NeighList(n);
+    if (p <= 0.0 || n < 2) return nl;
+
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    if (p >= 1.0) {
+        for (int u = 1; u < n; u++)
+            for (int v = 0; v < u; v++)
+                if (!skip || !((*skip)[u] && (*skip)[v])) addUndirected(nl, u, v);
+        return nl;
+    }
+
+    double logq = log(1.0 - p);
+    long long v = 1, w = -1;
+    while (v < n) {
+        double r = uniform(rng);
+        w += 1 + (long long)floor(log(1.0 - r) / logq);
+        while (w >= v && v < n) {
+            w -= v;
+            v++;
+        }
+        if (v < n && !(skip && (*skip)[v] && (*skip)[w])) {
+            addUndirected(nl, (int)v, (int)w);
+        }
+    }
+    return nl;
+}
+
+/*
+    Chung-Lu power-law graph: node i gets weight proportional to (i + 1)^(-1 / (exponent - 1)),
+    and about n * avgDeg / 2 edges are drawn with endpoints chosen proportionally to weight.
+    Self loops and duplicate edges are discarded.
+*/
+NeighList *generateChungLu(int n, double avgDeg, double exponent, uint64_t seed) {
+    NeighList *nl = new NeighList(n);
+    if (n < 2) return nl;
+
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    // Cumulative weights for inverse transform sampling
+    std::vector<double> cumulative(n);
+    double total = 0.0;
+    for (int i = 0; i < n; i++) {
+        total += pow(i + 1.0, -1.0 / (exponent - 1.0));
+        cumulative[i] = total;
+    }
+
+    long long edges = (long long)(n * avgDeg / 2.0);
+    std::vector<uint64_t> keys;
+    keys.reserve(edges);
+    for (long long e = 0; e < edges; e++) {
+        int u = std::lower_bound(cumulative.begin(), cumulative.end(), uniform(rng) * total) - cumulative.begin();
+        int v = std::lower_bound(cumulative.begin(), cumulative.end(), uniform(rng) * total) - cumulative.begin();
+        if (u >= n) u = n - 1;
+        if (v >= n) v = n - 1;
+        if (u == v) continue;
+        keys.push_back((uint64_t)std::min(u, v) << 32 | (uint64_t)std::max(u, v));
+    }
+
+    // Drop duplicate edges
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    for (uint64_t key : keys) addUndirected(nl, (int)(key >> 32), (int)(key & 0xffffffffULL));
+    return nl;
+}
+
+/*
+    Barabasi-Albert preferential attachment: starting from a clique of k + 1 nodes,
+    each new node connects to k distinct existing nodes chosen proportionally to degree.
+*/
+NeighList *generateBarabasiAlbert(int n, int k, uint64_t seed) {
+    NeighList *nl = new NeighList(n);
+    std::mt19937_64 rng(seed);
+
+    // Every edge endpoint is listed once, so a uniform pick is degree-proportional
+    std::vector<int> endpoints;
+    int start = std::min(n, k + 1);
+    for (int u = 0; u < start; u++) {
+        for (int v = 0; v < u; v++) {
+            addUndirected(nl, u, v);
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+
+    std::vector<int> targets;
+    for (int u = start; u < n; u++) {
+        targets.clear();
+        while ((int)targets.size() < k) {
+            int v = endpoints[rng() % endpoints.size()];
+            if (std::find(targets.begin(), targets.end(), v) == targets.end()) targets.push_back(v);
+        }
+        for (int v : targets) {
+            addUndirected(nl, u, v);
+            endpoints.push_back(u);
+            endpoints.push_back(v);
+        }
+    }
+    return nl;
+}
+
+/*
+    G(n, p) with a planted independent set of k random nodes (no edges among them),
+    so the optimum is at least k.
+*/
+NeighList *generatePlantedIS(int n, double p, int k, uint64_t seed) {
+    std::mt19937_64 rng(seed ^ 0x5DEECE66DULL);
+    std::vector<int> perm(n);
+    for (int i = 0; i < n; i++) perm[i] = i;
+    std::shuffle(perm.begin(), perm.end(), rng);
+
+    std::vector<char> planted(n, 0);
+    for (int i = 0; i < k && i < n; i++) planted[perm[i]] = 1;
+
+    return generateGnp(n, p, seed, &planted);
+}
+
+// Number of undirected edges of nl
+long long countEdges(NeighList *nl) {
+    long long total = 0;
+    for (int i = 0; i < nl->n; i++) total += nl->degrees[i];
+    return total / 2;
+}
+
+// Write nl in the format read by loadGraph. Returns false on error.
+bool saveGraph(NeighList *nl, const char *filename) {
+    FILE *fp = fopen(filename, "w");
+    if (fp == NULL) {
+        perror("Error opening file");
+        return false;
+    }
+    fprintf(fp, "%d\n", nl->n);
+    for (int u = 0; u < nl->n; u++) {
+        for (int v : nl->neighbors(u)) {
+            if (u < v) fprintf(fp, "%d %d\n", u, v);
+        }
+    }
+    fclose(fp);
+    return true;
+}
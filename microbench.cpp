@@ -0,0 +1,262 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "MMAS.h"
+#include "loader.h"
+#include "generator.h"
+#include "PerfCounters.h"
+
+/*
+    Microbenchmarks of the solver's hot kernels on seeded synthetic graphs.
+    Each kernel runs a fixed number of repetitions; only the kernel itself is
+    timed (setup between repetitions is excluded). Reported per graph and kernel:
+    ns per operation, vertices processed per second and, when perf_event_open
+    is available, cycles, instructions, cache and branch misses per operation.
+*/
+
+// One benchmark graph
+struct MicroGraph {
+    const char *name;
+    const char *model;      // "gnp" or "chunglu"
+    int n;
+    double param;           // gnp: p, chunglu: average degree
+};
+
+static const MicroGraph GRAPHS[] = {
+    {"gnp_1k_p0.1",       "gnp",     1000,    0.1},
+    {"gnp_1k_p0.5",       "gnp",     1000,    0.5},
+    {"gnp_10k_d20",       "gnp",     10000,   0.002},
+    {"chunglu_100k_d10",  "chunglu", 100000,  10.0},
+};
+static const int NUM_GRAPHS = sizeof(GRAPHS) / sizeof(GRAPHS[0]);
+
+// Accumulated measurement of one kernel
+struct MicroResult {
+    double seconds;         // time inside the kernel
+    long long ops;          // operations performed
+    long long vertices;     // vertices processed
+    PerfCounters *perf;
+
+    MicroResult(PerfCounters *perf) : seconds(0.0), ops(0), vertices(0), perf(perf) {
+        perf->reset();
+    }
+
+    template <typename F>
+    void time(F kernel) {
+        perf->start();
+        auto start = std::chrono::high_resolution_clock::now();
+        kernel();
+        auto end = std::chrono::high_resolution_clock::now();
+        perf->stop();
+        seconds += std::chrono::duration<double>(end - start).count();
+    }
+};
+
+void printHeader() {
+    printf("Kernel,Graph,Nodes,Edges,Ops,ns_per_op,vertices_per_s,cycles_per_op,instructions_per_op,cache_misses_per_op,branch_misses_per_op\n");
+}
+
+// Hardware counter column: per-op value or NA if the event is unavailable
+void printCounter(const PerfCounters *perf, int e, uint64_t value, long long ops) {
+    if (perf->available(e) && ops > 0) {
+        printf(",%.1f", (double)value / ops);
+    } else {
+        printf(",NA");
+    }
+}
+
+void printResult(const char *kernel, const MicroGraph &g, NeighList *nl, const MicroResult &r) {
+    double nsPerOp = r.ops > 0 ? r.seconds * 1e9 / r.ops : 0.0;
+    double verticesPerSec = r.seconds > 0 ? r.vertices / r.seconds : 0.0;
+    printf("%s,%s,%d,%lld,%lld,%.1f,%.0f", kernel, g.name, nl->n, countEdges(nl), r.ops, nsPerOp, verticesPerSec);
+    printCounter(r.perf, PerfCounters::CYCLES, r.perf->cycles(), r.ops);
+    printCounter(r.perf, PerfCounters::INSTRUCTIONS, r.perf->instructions(), r.ops);
+    printCounter(r.perf, PerfCounters::CACHE_MISSES, r.perf->cacheMisses(), r.ops);
+    printCounter(r.perf, PerfCounters::BRANCH_MISSES, r.perf->branchMisses(), r.ops);
+    printf("\n");
+    fflush(stdout);
+}
+
+bool selected(const char *only, const char *kernel) {
+    return only == nullptr || strcmp(only, kernel) == 0;
+}
+
+int main(int argc, char *argv[]) {
+    int reps = 10;                  // repetitions per kernel
+    int maxNodes = 10000;           // skip graphs larger than this (full construction and local search are superlinear)
+    char *only = nullptr;           // run a single kernel
+    uint64_t seed = 1;              // graph and ant seed
+
+    // Default MMAS parameters of benchmark.cpp
+    float alpha = 2.0f, beta = 3.0f, gamma = 0.0f, delta = 0.1f;
+    float rho = 0.9272f, tau_min = 7.0768f, tau_max = 522.4943f;
+    int ls_budget = 5;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-reps") == 0 && i + 1 < argc) {
+            reps = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-max-n") == 0 && i + 1 < argc) {
+            maxNodes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-only") == 0 && i + 1 < argc) {
+            only = argv[++i];
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "Usage: %s [-reps <n>] [-max-n <nodes>] [-only <kernel>] [-s <seed>]\n", argv[0]);
+            fprintf(stderr, "  -reps <n>       : Repetitions per kernel (default: %d)\n", reps);
+            fprintf(stderr, "  -max-n <nodes>  : Skip graphs with more nodes (default: %d)\n", maxNodes);
+            fprintf(stderr, "  -only <kernel>  : Run a single kernel: loadGraph, buildDegeneracy, buildWeights,\n");
+            fprintf(stderr, "                    constructSolution, addRemoveNode, try1Adds, localSearch, evaporate\n");
+            fprintf(stderr, "  -s <seed>       : Graph and ant seed (default: 1)\n");
+            return 1;
+        }
+    }
+    if (reps < 1) reps = 1;
+
+    PerfCounters perf;
+    if (!perf.anyAvailable()) {
+        fprintf(stderr, "Hardware counters unavailable (perf_event_open), reporting time only\n");
+    }
+
+    printHeader();
+
+    for (int gi = 0; gi < NUM_GRAPHS; gi++) {
+        const MicroGraph &g = GRAPHS[gi];
+        if (g.n > maxNodes) continue;
+
+        NeighList *nl = strcmp(g.model, "gnp") == 0 ? generateGnp(g.n, g.param, seed)
+                                                     : generateChungLu(g.n, g.param, 2.5, seed);
+
+        // loadGraph: parse the graph from a file in the benchmark format
+        if (selected(only, "loadGraph")) {
+            char path[] = "/tmp/microbench_XXXXXX";
+            int fd = mkstemp(path);
+            if (fd >= 0) {
+                close(fd);
+                saveGraph(nl, path);
+                MicroResult r(&perf);
+                for (int rep = 0; rep < reps; rep++) {
+                    NeighList *loaded = nullptr;
+                    r.time([&] { loaded = loadGraph(path); });
+                    r.ops++;
+                    r.vertices += nl->n;
+                    delete loaded;
+                }
+                unlink(path);
+                printResult("loadGraph", g, nl, r);
+            }
+        }
+
+        // buildDegeneracy: sequential core decomposition
+        if (selected(only, "buildDegeneracy")) {
+            MicroResult r(&perf);
+            for (int rep = 0; rep < reps; rep++) {
+                r.time([&] { nl->buildDegeneracy(); });
+                r.ops++;
+                r.vertices += nl->n;
+            }
+            printResult("buildDegeneracy", g, nl, r);
+        }
+        if (nl->degeneracy == nullptr) nl->buildDegeneracy();
+
+        pheromoneArray pheromones(nl->n, rho, tau_min, tau_max);
+        std::mt19937 rng((unsigned int)seed);
+        Ant ant(nl, &pheromones, alpha, beta, gamma, delta, &rng);
+
+        vector<int> allNodes(nl->n);
+        for (int i = 0; i < nl->n; i++) allNodes[i] = i;
+
+        // buildWeights: one candidate/weight pass over every node
+        if (selected(only, "buildWeights")) {
+            MicroResult r(&perf);
+            vector<int> candidates;
+            vector<float> weights;
+            for (int rep = 0; rep < reps; rep++) {
+                ant.reset();
+                r.time([&] { ant.buildWeights(candidates, weights, allNodes); });
+                r.ops++;
+                r.vertices += nl->n;
+            }
+            printResult("buildWeights", g, nl, r);
+        }
+
+        // constructSolution: one full ant construction
+        if (selected(only, "constructSolution")) {
+            MicroResult r(&perf);
+            for (int rep = 0; rep < reps; rep++) {
+                ant.reset();
+                r.time([&] { ant.constructSolution(); });
+                r.ops++;
+                r.vertices += nl->n;
+            }
+            printResult("constructSolution", g, nl, r);
+        }
+        ant.reset();
+        ant.constructSolution();
+        vector<int> constructed = ant.sol->solution;
+
+        // addNode/removeNode: insert and remove every node of a maximal independent set
+        if (selected(only, "addRemoveNode")) {
+            MicroResult r(&perf);
+            MISP_Solution sol(nl);
+            vector<int> order = constructed;
+            for (int rep = 0; rep < reps; rep++) {
+                std::shuffle(order.begin(), order.end(), rng);
+                r.time([&] {
+                    for (int node : constructed) sol.addNode(node);
+                    for (int node : order) sol.removeNode(node);
+                });
+                r.ops += 2 * constructed.size();
+                r.vertices += 2 * constructed.size();
+            }
+            printResult("addRemoveNode", g, nl, r);
+        }
+
+        // try1Adds: complete a solution holding every other node of a constructed one
+        if (selected(only, "try1Adds")) {
+            MicroResult r(&perf);
+            vector<int> half;
+            for (size_t i = 0; i < constructed.size(); i += 2) half.push_back(constructed[i]);
+            for (int rep = 0; rep < reps; rep++) {
+                MISP_Solution sol(nl, half.data(), half.size());
+                r.time([&] { try1Adds(&sol); });
+                r.ops++;
+                r.vertices += nl->n;
+            }
+            printResult("try1Adds", g, nl, r);
+        }
+
+        // localSearch: improve a constructed solution with the default budget
+        if (selected(only, "localSearch")) {
+            MicroResult r(&perf);
+            for (int rep = 0; rep < reps; rep++) {
+                MISP_Solution sol(nl, constructed.data(), constructed.size());
+                r.time([&] { localSearch(&sol, ls_budget); });
+                r.ops++;
+                r.vertices += nl->n;
+            }
+            printResult("localSearch", g, nl, r);
+        }
+
+        // evaporate: one evaporation pass over the pheromone array
+        if (selected(only, "evaporate")) {
+            MicroResult r(&perf);
+            int passes = reps * 10;
+            for (int rep = 0; rep < passes; rep++) {
+                r.time([&] { pheromones.evaporate(); });
+                r.ops++;
+                r.vertices += nl->n;
+            }
+            printResult("evaporate", g, nl, r);
+        }
+
+        fprintf(stderr, "%s done\n", g.name);
+        delete nl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,288 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "MMAS.h"
+#include "RunConfig.h"
+#include "generator.h"
+
+/*
+    Macro regression benchmark: runs MMAS on a grid of seeded synthetic graphs,
+    every graph model at every size (10^3 to 10^6 nodes) and average degree,
+    with deterministic iteration budgets. Writes the results as CSV and
+    compares them against a stored baseline.
+    Solution sizes and work units are deterministic, so the stored baseline
+    holds only those: a lower best size is a quality regression, a different
+    work count means the search itself changed. Throughput (work units per
+    second) depends on the machine; it is compared only with -throughput,
+    against a results CSV taken on the same machine.
+*/
+
+// Graph models of the grid
+static const char *MODELS[] = {"gnp", "planted", "chunglu", "ba"};
+static const int NUM_MODELS = sizeof(MODELS) / sizeof(MODELS[0]);
+
+// Average degrees of the grid
+static const int DEGREES[] = {4, 16, 64, 256};
+static const int NUM_DEGREES = sizeof(DEGREES) / sizeof(DEGREES[0]);
+
+// Graph size of the grid and the solver configuration used at that size
+struct RegressionSize {
+    const char *label;
+    int n;
+    int m;                  // ants
+    int iterations;         // deterministic budget
+    int ls_budget;          // local search budget
+    int candidateK;         // candidate list size (0 = full candidate set)
+    double ilsFraction;     // intensification share of work (0 = off)
+};
+
+static const RegressionSize SIZES[] = {
+    // label  n        m   it  ls  cl  ils
+    {"1k",    1000,    10, 20, 5,  0,  0.0},
+    {"10k",   10000,   10, 20, 0,  64, 0.3},
+    {"100k",  100000,  4,  5,  0,  64, 0.3},
+    {"1M",    1000000, 2,  2,  0,  64, 0.2},
+};
+static const int NUM_SIZES = sizeof(SIZES) / sizeof(SIZES[0]);
+
+// One grid point
+struct RegressionCase {
+    std::string name;       // <model>_<size>_d<degree>
+    const char *model;
+    int degree;
+    const RegressionSize *size;
+};
+
+// Measured result of one case
+struct RegressionResult {
+    std::string name;
+    int n;
+    long long edges;
+    int best;
+    int iterations;
+    long long work;
+    bool timed;             // seconds/workPerSec are set (not in a stored baseline)
+    double seconds;
+    double workPerSec;
+};
+
+NeighList *generateCase(const RegressionCase &c, uint64_t seed) {
+    int n = c.size->n;
+    double p = (double)c.degree / (n - 1);
+    if (strcmp(c.model, "gnp") == 0) return generateGnp(n, p, seed);
+    if (strcmp(c.model, "planted") == 0) return generatePlantedIS(n, p, n / 25, seed);
+    if (strcmp(c.model, "chunglu") == 0) return generateChungLu(n, c.degree, 2.5, seed);
+    if (strcmp(c.model, "ba") == 0) return generateBarabasiAlbert(n, c.degree / 2, seed);
+    return nullptr;
+}
+
+// The full grid, sizes outer, then degrees, then models
+std::vector<RegressionCase> buildGrid() {
+    std::vector<RegressionCase> cases;
+    for (int si = 0; si < NUM_SIZES; si++) {
+        for (int di = 0; di < NUM_DEGREES; di++) {
+            for (int mi = 0; mi < NUM_MODELS; mi++) {
+                char name[64];
+                snprintf(name, sizeof(name), "%s_%s_d%d", MODELS[mi], SIZES[si].label, DEGREES[di]);
+                cases.push_back({name, MODELS[mi], DEGREES[di], &SIZES[si]});
+            }
+        }
+    }
+    return cases;
+}
+
+// Read a results or baseline CSV written by this program. Returns false on error.
+bool loadResults(const char *filename, std::vector<RegressionResult> &results) {
+    FILE *fp = fopen(filename, "r");
+    if (fp == NULL) {
+        perror("Error opening baseline file");
+        return false;
+    }
+    char line[512];
+    if (fgets(line, sizeof(line), fp) == NULL) {   // header
+        fclose(fp);
+        return false;
+    }
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        char name[128];
+        RegressionResult r;
+        int fields = sscanf(line, "%127[^,],%d,%lld,%d,%d,%lld,%lf,%lf", name, &r.n, &r.edges, &r.best,
+                            &r.iterations, &r.work, &r.seconds, &r.workPerSec);
+        if (fields == 6 || fields == 8) {
+            r.name = name;
+            r.timed = fields == 8;
+            results.push_back(r);
+        }
+    }
+    fclose(fp);
+    return true;
+}
+
+// Write results; timing columns are omitted for a stored baseline
+void writeResults(FILE *fp, const std::vector<RegressionResult> &results, bool timing) {
+    fprintf(fp, timing ? "Case,Nodes,Edges,Best,Iterations,Work,Time(s),Work_per_s\n" : "Case,Nodes,Edges,Best,Iterations,Work\n");
+    for (const RegressionResult &r : results) {
+        fprintf(fp, "%s,%d,%lld,%d,%d,%lld", r.name.c_str(), r.n, r.edges, r.best, r.iterations, r.work);
+        if (timing) fprintf(fp, ",%.4f,%.0f", r.seconds, r.workPerSec);
+        fprintf(fp, "\n");
+    }
+}
+
+int main(int argc, char *argv[]) {
+    char *outPath = nullptr;        // results CSV (default: stdout)
+    char *savePath = nullptr;       // baseline CSV to write (deterministic columns only)
+    char *baselinePath = nullptr;   // baseline CSV to compare against
+    bool throughput = false;        // also compare work units per second
+    double tolerance = 0.15;        // allowed relative throughput drop
+    int maxNodes = 1000000;         // skip cases larger than this
+    long long maxEdges = 10000000;  // skip cases whose expected edge count is larger than this
+    char *only = nullptr;           // run a single case
+    uint64_t seed = 1;              // graph and solver seed
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        } else if (strcmp(argv[i], "-save") == 0 && i + 1 < argc) {
+            savePath = argv[++i];
+        } else if (strcmp(argv[i], "-baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (strcmp(argv[i], "-throughput") == 0) {
+            throughput = true;
+        } else if (strcmp(argv[i], "-tol") == 0 && i + 1 < argc) {
+            tolerance = atof(argv[++i]);
+        } else if (strcmp(argv[i], "-max-n") == 0 && i + 1 < argc) {
+            maxNodes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-max-m") == 0 && i + 1 < argc) {
+            maxEdges = strtoll(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "-only") == 0 && i + 1 < argc) {
+            only = argv[++i];
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "Usage: %s [-o <results.csv>] [-save <baseline.csv>] [-baseline <baseline.csv>] [-throughput] [-tol <fraction>] [-max-n <nodes>] [-max-m <edges>] [-only <case>] [-s <seed>]\n", argv[0]);
+            fprintf(stderr, "  -o <file>        : Write results CSV (with timings) to file (default: stdout)\n");
+            fprintf(stderr, "  -save <file>     : Write a baseline CSV (best size and work only, machine independent)\n");
+            fprintf(stderr, "  -baseline <file> : Compare against a baseline or results CSV, exit 2 on regression\n");
+            fprintf(stderr, "  -throughput      : Also flag work/s drops; needs a results CSV from the same machine\n");
+            fprintf(stderr, "  -tol <fraction>  : Allowed relative throughput drop with -throughput (default: %.2f)\n", tolerance);
+            fprintf(stderr, "  -max-n <nodes>   : Skip cases with more nodes (default: %d)\n", maxNodes);
+            fprintf(stderr, "  -max-m <edges>   : Skip cases with more expected edges (default: %lld)\n", maxEdges);
+            fprintf(stderr, "  -only <case>     : Run a single case, e.g. gnp_10k_d16\n");
+            fprintf(stderr, "  -s <seed>        : Graph and solver seed (default: 1)\n");
+            return 1;
+        }
+    }
+
+    std::vector<RegressionResult> results;
+
+    for (const RegressionCase &c : buildGrid()) {
+        const RegressionSize &size = *c.size;
+        if (size.n > maxNodes || (long long)size.n * c.degree / 2 > maxEdges) continue;
+        if (only != nullptr && c.name != only) continue;
+
+        NeighList *nl = generateCase(c, seed);
+
+        // Shipped defaults of benchmark.cpp with the size tier's overrides
+        RunConfig config;
+        config.time_limit = 0.0;
+        config.max_iterations = size.iterations;
+        config.m = size.m;
+        config.ls_budget = size.ls_budget;
+        config.candidateK = size.candidateK;
+        config.ilsFraction = size.ilsFraction;
+        config.seed = (unsigned int)seed;
+        MMASSolver *solver = config.createSolver(nl, false);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        int best = solver->solve(config.time_limit, config.max_iterations, config.max_work);
+        auto end = std::chrono::high_resolution_clock::now();
+
+        RegressionResult r;
+        r.name = c.name;
+        r.n = nl->n;
+        r.edges = countEdges(nl);
+        r.best = best;
+        r.iterations = solver->iterations;
+        r.work = solver->work;
+        r.timed = true;
+        r.seconds = std::chrono::duration<double>(end - start).count();
+        r.workPerSec = r.seconds > 0 ? r.work / r.seconds : 0.0;
+        results.push_back(r);
+
+        fprintf(stderr, "%-20s n=%-8d m=%-9lld best=%-7d %.2fs\n", r.name.c_str(), r.n, r.edges, r.best, r.seconds);
+
+        delete solver;
+        delete nl;
+    }
+
+    FILE *out = stdout;
+    if (outPath != nullptr) {
+        out = fopen(outPath, "w");
+        if (out == NULL) {
+            perror("Error opening output file");
+            return 1;
+        }
+    }
+    writeResults(out, results, true);
+    if (out != stdout) fclose(out);
+
+    if (savePath != nullptr) {
+        FILE *fp = fopen(savePath, "w");
+        if (fp == NULL) {
+            perror("Error opening baseline file");
+            return 1;
+        }
+        writeResults(fp, results, false);
+        fclose(fp);
+    }
+
+    if (baselinePath == nullptr) {
+        return 0;
+    }
+
+    std::vector<RegressionResult> baseline;
+    if (!loadResults(baselinePath, baseline)) {
+        fprintf(stderr, "Error: Could not read baseline: %s\n", baselinePath);
+        return 1;
+    }
+
+    int regressions = 0;
+    for (const RegressionResult &r : results) {
+        const RegressionResult *b = nullptr;
+        for (const RegressionResult &candidate : baseline) {
+            if (candidate.name == r.name) b = &candidate;
+        }
+        if (b == nullptr) {
+            fprintf(stderr, "%-20s no baseline\n", r.name.c_str());
+            continue;
+        }
+        if (b->n != r.n || b->edges != r.edges) {
+            fprintf(stderr, "%-20s graph differs from baseline (%d/%lld vs %d/%lld), skipped\n",
+                    r.name.c_str(), r.n, r.edges, b->n, b->edges);
+            continue;
+        }
+        if (r.best < b->best) {
+            fprintf(stderr, "%-20s QUALITY REGRESSION: best %d < baseline %d\n", r.name.c_str(), r.best, b->best);
+            regressions++;
+        } else if (r.best > b->best) {
+            fprintf(stderr, "%-20s quality improved: best %d > baseline %d\n", r.name.c_str(), r.best, b->best);
+        }
+        if (r.work != b->work) {
+            fprintf(stderr, "%-20s search changed: work %lld vs baseline %lld\n", r.name.c_str(), r.work, b->work);
+        }
+        if (throughput) {
+            if (!b->timed) {
+                fprintf(stderr, "%-20s baseline has no timings, throughput not compared\n", r.name.c_str());
+            } else if (r.workPerSec < b->workPerSec * (1.0 - tolerance)) {
+                fprintf(stderr, "%-20s THROUGHPUT REGRESSION: %.0f work/s < baseline %.0f\n", r.name.c_str(), r.workPerSec, b->workPerSec);
+                regressions++;
+            }
+        }
+    }
+
+    fprintf(stderr, "%d regression(s)\n", regressions);
+    return regressions > 0 ? 2 : 0;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstring>
+#include <cstdint>
 #include <iostream>
 #include <algorithm>
 #include <vector>
@@ -11,14 +12,26 @@ struct MISP_Solution {
     NeighList *graph;
     std::vector<int> solution;
     int *MISP_IndependentDegree;
+    int *position;                  // index of each solution node in solution (valid for solution nodes only)
+    std::vector<int> *journal;      // optional change log: node when added, ~node when removed
+    long long work;                 // abstract work units: adjacency entries / nodes touched
+    uint64_t hash;                  // Zobrist hash of the node set (0 if graph->zobrist is not built)
 
     MISP_Solution(NeighList *nl) {
         graph = nl;
+        work = 0;
+        hash = 0;
+        journal = nullptr;
+        position = new int[nl->n];
         MISP_IndependentDegree = new int[nl->n];
         memset(MISP_IndependentDegree, 0, nl->n * sizeof(int));
     }
     MISP_Solution(NeighList *nl, int *nodes, int sz) {
         graph = nl;
+        work = 0;
+        hash = 0;
+        journal = nullptr;
+        position = new int[nl->n];
         MISP_IndependentDegree = new int[nl->n];
         memset(MISP_IndependentDegree, 0, nl->n * sizeof(int));
 
@@ -29,6 +42,7 @@ struct MISP_Solution {
     }
     ~MISP_Solution() {
         delete[] MISP_IndependentDegree;
+        delete[] position;
     }
 
     int size() const {
@@ -41,27 +55,35 @@ struct MISP_Solution {
             return;
         }
 
+        position[node] = solution.size();
         solution.push_back(node);
+        if (journal) journal->push_back(node);
+        work += graph->degrees[node];
+        if (graph->zobrist) hash ^= graph->zobrist[node];
         MISP_IndependentDegree[node] = -1;
-        for (int neighbor : graph->neighborhoods[node]) {
+        for (int neighbor : graph->neighbors(node)) {
             MISP_IndependentDegree[neighbor] += 1;
         }
     }
     void removeNode(int node) {
-        // Find and remove node from solution
-        auto found = std::find(solution.begin(), solution.end(), node);
-        if (found != solution.end()) {
+        // Remove node from solution
+        if (MISP_IndependentDegree[node] == -1) {
             // Node found, swap with last and pop
-            *found = solution.back();
+            int last = solution.back();
+            solution[position[node]] = last;
+            position[last] = position[node];
             solution.pop_back();
+            if (journal) journal->push_back(~node);
         } else {
             std::cerr << "Error: Trying to remove a non-existing node" << node << "from MISP_Solution";
             return;
         }
 
         MISP_IndependentDegree[node] = 0;
+        work += graph->degrees[node];
+        if (graph->zobrist) hash ^= graph->zobrist[node];
         // Re-evaluate independence of neighbors
-        for (int neighbor : graph->neighborhoods[node]) {
+        for (int neighbor : graph->neighbors(node)) {
             MISP_IndependentDegree[neighbor] -= 1;
         }
     }